@@ -0,0 +1,68 @@
+
+/**
+ * @file simctl.cpp
+ * @brief Cliente de consulta en vivo del simulador (ver include/monitor.h).
+ *
+ * Uso: simctl SOCKET [--cada=SEG]
+ * Se conecta al socket Unix abierto con "simulador --monitor=SOCKET", imprime la respuesta
+ * (líneas clave=valor) y termina. Con --cada repite la consulta cada SEG segundos hasta
+ * que la simulación termina o el socket deja de responder.
+ */
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Lee la instantánea completa (el servidor cierra la conexión al terminar de enviar)
+static bool consultar(const std::string& ruta, std::string& respuesta) {
+    sockaddr_un dir{};
+    if (ruta.size() >= sizeof(dir.sun_path)) return false;
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    dir.sun_family = AF_UNIX;
+    std::strcpy(dir.sun_path, ruta.c_str());
+    if (connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0) { close(fd); return false; }
+    respuesta.clear();
+    char buf[4096];
+    ssize_t k;
+    while ((k = read(fd, buf, sizeof(buf))) > 0) respuesta.append(buf, static_cast<size_t>(k));
+    close(fd);
+    return k == 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string ruta;
+    int cada = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--cada=", 0) == 0) {
+            try { cada = std::stoi(arg.substr(7)); } catch (...) { cada = -1; }
+            if (cada <= 0) { std::cerr << "Valor invalido en: " << arg << "\n"; return 1; }
+        } else if (ruta.empty()) {
+            ruta = arg;
+        } else {
+            std::cerr << "Argumento de mas: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (ruta.empty()) {
+        std::cerr << "Uso: simctl SOCKET [--cada=SEG]\n";
+        return 1;
+    }
+
+    std::string r;
+    for (bool primera = true;; primera = false) {
+        if (!consultar(ruta, r)) {
+            if (primera) std::cerr << "No se pudo consultar " << ruta << "\n";
+            return primera ? 1 : 0;
+        }
+        if (!primera) std::cout << "\n";
+        std::cout << r << std::flush;
+        if (cada == 0 || r.find("estado=terminada") != std::string::npos) return 0;
+        std::this_thread::sleep_for(std::chrono::seconds(cada));
+    }
+}
@@ -0,0 +1,54 @@
+
+/**
+ * @file analisis.h
+ * @brief Análisis estático de programas decodificados, hecho una vez al cargarlos.
+ *
+ * El lenguaje no tiene saltos condicionales: cada instrucción tiene un único sucesor
+ * (la siguiente, o el destino de JMP; el fin del programa se representa con el índice n).
+ * El grafo de control es entonces funcional y desde la instrucción 0 hay un solo camino,
+ * que termina en el fin o entra en un ciclo. Sobre ese grafo se calcula:
+ * - JMP fuera de rango (el proceso termina) y JMP a sí mismo (bucle sin efecto);
+ * - código muerto: instrucciones fuera del camino desde la 0;
+ * - la cantidad exacta de instrucciones si el camino termina (sin ciclos);
+ * - por cada PC, la ráfaga de CPU: instrucciones hasta el próximo IO/SLEEP inclusive o el fin.
+ *
+ * Los conteos suponen que ningún LOAD/STORE viola el segmento (eso termina antes al proceso).
+ */
+
+ /**
+    * @brief Analiza un programa ya decodificado.
+    * @param prog Programa (decodificarPrograma ya normalizó los JMP fuera de rango al fin).
+    * @return Grafo de control, avisos y longitudes precalculadas.
+    */
+
+ /**
+    * @brief Escribe los avisos del análisis (uno por línea); nada si el programa está limpio.
+    * @param os Flujo de salida (normalmente std::cerr).
+    * @param a Resultado de analizarPrograma.
+    * @param nombre Origen del programa para los mensajes (archivo o "PID n").
+    * @return Cantidad de avisos escritos.
+    */
+#ifndef ANALISIS_H
+#define ANALISIS_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include "programa.h"
+
+struct AnalisisPrograma {
+    std::vector<int32_t> sucesor;         // grafo de control: siguiente PC de cada instrucción
+    std::vector<uint8_t> alcanzable;      // en el camino desde la instrucción 0
+    std::vector<int> saltosFueraDeRango;  // índices de JMP cuyo destino no existe
+    std::vector<int> saltosASiMismo;
+    std::vector<int> muertas;             // índices no alcanzables
+    long long instrucciones = -1;         // total exacto desde PC=0; -1 si no termina
+    std::vector<long long> rafaga;        // por PC: hasta IO/SLEEP o el fin; -1 = infinita
+    std::vector<long long> restantes;     // por PC: hasta el fin; -1 = no termina
+};
+
+AnalisisPrograma analizarPrograma(const Programa& prog);
+int reportarAnalisis(std::ostream& os, const AnalisisPrograma& a, const std::string& nombre);
+
+#endif // ANALISIS_H
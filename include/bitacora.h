@@ -0,0 +1,78 @@
+
+/**
+ * @file bitacora.h
+ * @brief Bitácora compacta de rebanadas y reconstrucción bajo demanda de la traza detallada.
+ *
+ * En lugar de imprimir "Instr[i] ... Quantum restante" por cada instrucción, el planificador
+ * puede registrar un resumen por rebanada: proceso, instante y PC de inicio, cantidad de
+ * instrucciones y la variación de AX/BX/CX. Las rebanadas con LOAD/STORE guardan además el
+ * resultado de cada acceso (valor, página, marco, TLB), porque la memoria no se puede
+ * reconstruir sin re-ejecutar toda la corrida.
+ *
+ * renderizar() rehace el estado de inicio de cada rebanada pedida (registros iniciales del
+ * proceso + variaciones acumuladas) y la vuelve a ejecutar aislada con el motor de
+ * referencia, que imprime exactamente la misma traza que la corrida completa.
+ */
+
+ /**
+    * @brief Vuelve a ejecutar y muestra la traza de las rebanadas seleccionadas.
+    * @param os Flujo de salida (también recibe los avisos "! ..." del intérprete).
+    * @param desde Primera rebanada (numeración desde 1, como en imprimirResumen).
+    * @param hasta Última rebanada (inclusive); -1 = hasta el final.
+    * @param pid Solo las rebanadas de este PID; -1 = todas.
+    * @return Cantidad de rebanadas mostradas.
+    */
+#ifndef BITACORA_H
+#define BITACORA_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include "proceso.h"
+#include "motor.h"
+#include "catalogo.h"
+
+struct ResumenRebanada {
+    int64_t inicio;             // reloj al empezar (después del costo de cambio)
+    int64_t dispositivoLibre;   // estado del dispositivo de E/S al empezar
+    int32_t proceso;            // índice en la bitácora (no la ranura del planificador)
+    int32_t pcInicio;
+    int32_t instrucciones;
+    bool cortada;               // detenida por el tope de instrucciones
+    Registro dax, dbx, dcx;     // variación de los registros (módulo 2^bits)
+    uint64_t primerAcceso;      // posición en la lista de accesos grabados
+    uint32_t nAccesos;
+};
+
+class BitacoraRebanadas {
+public:
+    // Devuelve el índice con el que se identifican las rebanadas del proceso
+    int registrarProceso(const Proceso& p, const std::vector<std::string>& programa);
+
+    // Rodean la ejecución de una rebanada (iniciar conecta la grabación de accesos a st)
+    void iniciarRebanada(int proceso, const Proceso& p, EstadoEjecucion& st);
+    void terminarRebanada(const Proceso& p, EstadoEjecucion& st, bool cortada);
+
+    size_t rebanadas() const { return rebanadas_.size(); }
+    void imprimirResumen(std::ostream& os) const;
+    long long renderizar(std::ostream& os, long long desde, long long hasta, int pid) const;
+
+private:
+    struct ProcesoBitacora {
+        int pid;
+        int quantum;
+        Registro ax, bx, cx;    // registros al ser admitido
+        int programa;
+    };
+
+    std::vector<ProcesoBitacora> procesos_;
+    std::vector<std::vector<std::string>> programas_;   // distintos, por contenido
+    std::unordered_multimap<uint64_t, int> indicePrograma_;
+    std::vector<ResumenRebanada> rebanadas_;
+    std::vector<AccesoMemoria> accesos_;
+    Proceso inicio_{};          // estado al iniciar la rebanada en curso
+    long long instrInicio_ = 0;
+};
+
+#endif // BITACORA_H
@@ -7,12 +7,32 @@
  * (por ejemplo, "procesos.txt") o desde la entrada estándar (consola). Los procesos
  * cargados se almacenan internamente y pueden ser accedidos mediante un método getter.
  */
+
+ /**
+    * @class FuenteProcesos
+    * @brief Origen de procesos para la admisión en flujo (PlanificadorRoundRobin::simular).
+    *
+    * siguiente() entrega el próximo proceso (en orden de llegada no decreciente) junto con
+    * su programa, internado en el catálogo recibido (con una referencia a cargo del
+    * llamador); devuelve false cuando no quedan más.
+    */
+
+ /**
+    * @class CargadorProcesosFlujo
+    * @brief Lee procesos de a uno desde un archivo o la entrada estándar ("-").
+    *
+    * Cada línea se parsea recién cuando el planificador la pide y el programa se lee de
+    * <instrDir>/<PID>.txt en ese momento, por lo que la memoria no crece con el total de
+    * procesos. Una llegada menor a la anterior se ajusta a la anterior (con aviso).
+    */
 #ifndef CARGADOR_H
 #define CARGADOR_H
 
 #include <vector>
 #include <string>
+#include <fstream>
 #include "proceso.h"
+#include "catalogo.h"
 
 class CargadorProcesos {
 public:
@@ -28,6 +48,38 @@ private:
     std::vector<Proceso> procesos_;
 };
 
+class FuenteProcesos {
+public:
+    virtual ~FuenteProcesos() = default;
+    virtual bool siguiente(Proceso& p, CatalogoProgramas& catalogo, IdPrograma& programa) = 0;
+    // Si la admisión se cortó por un error (y no por fin de la entrada), el motivo para el
+    // reporte final; vacío en otro caso
+    virtual std::string interrupcion() const { return ""; }
+};
+
+class CargadorProcesosFlujo : public FuenteProcesos {
+public:
+    // filename = "-" para leer de la entrada estándar
+    bool abrir(const std::string& filename, const std::string& instrDir);
+    bool siguiente(Proceso& p, CatalogoProgramas& catalogo, IdPrograma& programa) override;
+
+    // true si la lectura se detuvo por una línea o un programa inválido
+    bool error() const { return error_; }
+    std::string interrupcion() const override;
+    long long leidos() const { return leidos_; }
+
+private:
+    std::ifstream archivo_;
+    std::istream* in_ = nullptr;
+    bool consola_ = false;        // "-": se lee con leerLineaEntrada (entrada.h)
+    std::string instrDir_;
+    int lineNum_ = 0;
+    int lineaError_ = 0;
+    int ultimaLlegada_ = 0;
+    long long leidos_ = 0;
+    bool error_ = false;
+};
+
 #endif // CARGADOR_H
 
 
@@ -0,0 +1,73 @@
+
+/**
+ * @file catalogo.h
+ * @brief Catálogo de programas internados: cada contenido distinto se guarda una sola vez.
+ *
+ * En cargas generadas a partir de plantillas miles de instr/<PID>.txt son idénticos. El
+ * catálogo identifica cada programa por un hash de su contenido (con comparación completa
+ * ante colisiones) y entrega un IdPrograma; los procesos guardan solo ese identificador.
+ * La decodificación (programa.h) y el análisis estático (analisis.h) se hacen una vez por
+ * programa distinto y los comparten todos los procesos que lo usan.
+ *
+ * Las entradas llevan un contador de referencias: en la admisión en flujo el planificador
+ * libera el programa de cada proceso que termina, y la entrada se recicla cuando ningún
+ * proceso vivo la usa (la memoria depende de los programas distintos vivos).
+ */
+
+ /**
+    * @brief Busca el programa en el catálogo o lo agrega (decodificado y analizado).
+    * @param lineas Instrucciones en texto, ya validadas.
+    * @param nuevo Si no es nulo, recibe true cuando el contenido no estaba en el catálogo.
+    * @return Identificador del programa; suma una referencia.
+    */
+
+ /**
+    * @brief Busca un programa por contenido sin agregarlo.
+    * @return Identificador (sumando una referencia) o -1 si no está.
+    */
+#ifndef CATALOGO_H
+#define CATALOGO_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "programa.h"
+#include "analisis.h"
+
+using IdPrograma = int32_t;
+
+// Hash FNV-1a de 64 bits del contenido de un programa (línea a línea)
+uint64_t hashPrograma(const std::vector<std::string>& lineas);
+
+class CatalogoProgramas {
+public:
+    IdPrograma internar(const std::vector<std::string>& lineas, bool* nuevo = nullptr);
+    IdPrograma retener(const std::vector<std::string>& lineas, uint64_t hash);
+    // Resta una referencia; sin referencias, la entrada se vacía, su id se reutilizará y
+    // retorna true
+    bool liberar(IdPrograma id);
+
+    const std::vector<std::string>& texto(IdPrograma id) const { return entradas_[id].texto; }
+    const Programa& programa(IdPrograma id) const { return entradas_[id].programa; }
+    const AnalisisPrograma& analisis(IdPrograma id) const { return entradas_[id].analisis; }
+
+    // Los ids válidos están en [0, capacidad())
+    size_t capacidad() const { return entradas_.size(); }
+    size_t distintos() const { return entradas_.size() - libres_.size(); }
+
+private:
+    struct Entrada {
+        uint64_t hash = 0;
+        long long referencias = 0;
+        std::vector<std::string> texto;
+        Programa programa;
+        AnalisisPrograma analisis;
+    };
+
+    std::vector<Entrada> entradas_;
+    std::vector<IdPrograma> libres_;
+    std::unordered_multimap<uint64_t, IdPrograma> indice_;
+};
+
+#endif // CATALOGO_H
@@ -0,0 +1,47 @@
+
+/**
+ * @file diferencial.h
+ * @brief Pruebas diferenciales entre el motor de referencia y el motor decodificado.
+ *
+ * Genera cargas de trabajo pseudoaleatorias (reproducibles por semilla) que incluyen los
+ * casos límite de la semántica: opcodes desconocidos (→ NOP), operandos inválidos (el
+ * proceso cede la CPU sin avanzar), JMP fuera de rango (el proceso termina), direcciones
+ * fuera del espacio virtual, IO/SLEEP y bucles. Cada carga
+ * se ejecuta con ambos motores; el flujo de eventos de la referencia se graba en una traza
+ * temporal y el motor decodificado (o el paralelo) se verifica contra ella paso a paso. Se informa la
+ * primera instrucción divergente y la carga completa para reproducirla.
+ *
+ * Con un umbral de JIT (jit >= 0) cada carga se ejecuta además con el nivel nativo. El código
+ * nativo no emite eventos por instrucción (con un observador se interpreta), así que esa
+ * corrida va sin observador y se compara su reporte final (estados, Fin t=, métricas) con
+ * el de la referencia.
+ */
+
+ /**
+    * @brief Ejecuta las cargas configuradas con ambos motores y compara.
+    * @param cfg Parámetros de generación y de la simulación.
+    * @param os Flujo donde se informa el progreso y la primera divergencia.
+    * @return true si todas las cargas coinciden (eventos y estados finales).
+    */
+#ifndef DIFERENCIAL_H
+#define DIFERENCIAL_H
+
+#include <ostream>
+#include "planificador.h"
+
+struct ConfigDiferencial {
+    int cargas = 100;                   // cantidad de cargas generadas
+    unsigned long long semilla = 1;     // la carga k usa semilla + k
+    int procesos = 8;
+    int largo = 12;                     // instrucciones máximas por programa
+    long long limite = 20000;           // tope de instrucciones por carga
+    Motor motor = Motor::DECODIFICADO;  // motor comparado contra la referencia
+    unsigned hilos = 0;
+    long long jit = -1;                 // umbral del nivel JIT a comparar (-1 = no)
+    ConfigMemoria memoria;
+    ConfigCambioContexto cambio;
+};
+
+bool ejecutarDiferencial(const ConfigDiferencial& cfg, std::ostream& os);
+
+#endif // DIFERENCIAL_H
@@ -0,0 +1,36 @@
+
+/**
+ * @file entrada.h
+ * @brief Lectura de líneas de la entrada estándar compartida por el menú y los cargadores.
+ *
+ * Si la entrada estándar es una terminal se usa std::getline(std::cin) como siempre. Si
+ * viene de un pipe o un archivo redirigido (cargas generadas), los cargadores no muestran
+ * los avisos "> " y la entrada se lee con read() en bloques de 1 MiB, cortando las líneas
+ * dentro del bloque; así una carga por consola se lee tan rápido como desde archivo.
+ *
+ * Todas las lecturas de consola deben pasar por leerLineaEntrada(): en modo no interactivo
+ * el bloque ya leído no está en std::cin.
+ */
+
+ /**
+    * @brief Ajustes de la entrada según su origen; llamar una vez al inicio de main.
+    *
+    * Sin terminal desata std::cout de std::cin (no se vacía la salida en cada lectura).
+    */
+
+ /**
+    * @brief Lee la próxima línea (sin el '\n') de la entrada estándar.
+    * @return false al llegar al final de la entrada (la línea queda vacía).
+    */
+#ifndef ENTRADA_H
+#define ENTRADA_H
+
+#include <string>
+
+// true si la entrada estándar es una terminal (se consulta una sola vez)
+bool entradaInteractiva();
+
+void prepararEntrada();
+bool leerLineaEntrada(std::string& linea);
+
+#endif // ENTRADA_H
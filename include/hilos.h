@@ -0,0 +1,54 @@
+
+/**
+ * @file hilos.h
+ * @brief Pool de hilos mínimo para ejecutar lotes de tareas independientes.
+ *
+ * El planificador paralelo lo usa para ejecutar a la vez las rebanadas de todos los
+ * procesos de la cola de listos; el orden de los resultados lo decide después la fusión.
+ */
+
+ /**
+    * @class PoolHilos
+    * @brief Hilos trabajadores persistentes con un único lote activo a la vez.
+    *
+    * paraCada(n, f) ejecuta f(0) .. f(n-1) repartidas entre los trabajadores y el hilo
+    * llamador, y retorna cuando terminaron todas. No es reentrante.
+    */
+#ifndef HILOS_H
+#define HILOS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PoolHilos {
+public:
+    // hilos = total incluyendo al llamador (0 = los núcleos disponibles)
+    explicit PoolHilos(unsigned hilos = 0);
+    ~PoolHilos();
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    void paraCada(size_t n, const std::function<void(size_t)>& f);
+    unsigned hilos() const { return static_cast<unsigned>(trabajadores_.size()) + 1; }
+
+private:
+    void trabajar();
+    void consumir();   // toma índices del lote actual hasta agotarlo
+
+    std::vector<std::thread> trabajadores_;
+    std::mutex mtx_;
+    std::condition_variable hayTrabajo_, terminado_;
+    const std::function<void(size_t)>* tarea_ = nullptr;
+    size_t total_ = 0;
+    std::atomic<size_t> siguiente_{0};
+    size_t pendientes_ = 0;        // trabajadores aún dentro del lote actual
+    unsigned long long lote_ = 0;  // generación del lote (despierta a los trabajadores)
+    bool salir_ = false;
+};
+
+#endif // HILOS_H
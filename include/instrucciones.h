@@ -5,7 +5,8 @@
  * @brief Declaración de la clase CargadorInstrucciones para la gestión y validación de instrucciones de procesos.
  *
  * Esta clase permite cargar instrucciones para procesos desde archivos o desde la consola,
- * validando su formato y almacenándolas para su posterior uso en la simulación.
+ * validando su formato y almacenándolas para su posterior uso en la simulación. Los
+ * programas se internan en un CatalogoProgramas: cada proceso guarda solo un IdPrograma.
  */
 
  /**
@@ -30,8 +31,8 @@
     */
  
  /**
-    * @brief Obtiene las instrucciones cargadas para todos los procesos.
-    * @return Referencia constante a un vector de vectores de cadenas, donde cada subvector contiene las instrucciones de un proceso.
+    * @brief Obtiene el programa cargado de cada proceso.
+    * @return Un IdPrograma por proceso (en el orden recibido), a consultar en getCatalogo().
     */
 #ifndef INSTRUCCIONES_H
 #define INSTRUCCIONES_H
@@ -39,6 +40,11 @@
 #include <vector>
 #include <string>
 #include "proceso.h"
+#include "catalogo.h"
+
+// Lee un archivo de programa (una instrucción por línea, vacías ignoradas) y lo interna en
+// el catálogo. Solo un contenido nuevo se VALIDA y se analiza (los repetidos ya lo fueron).
+bool cargarProgramaArchivo(const std::string& path, CatalogoProgramas& catalogo, IdPrograma& id);
 
 class CargadorInstrucciones {
 public:
@@ -49,10 +55,12 @@ public:
     // Pide por consola las instrucciones por PID (END para terminar) y VALIDA
     bool cargarInstruccionesDesdeConsola(const std::vector<Proceso>& procesos);
 
-    const std::vector<std::vector<std::string>>& getInstrucciones() const;
+    const std::vector<IdPrograma>& getProgramas() const { return programas_; }
+    const CatalogoProgramas& getCatalogo() const { return catalogo_; }
 
 private:
-    std::vector<std::vector<std::string>> instrucciones_;
+    CatalogoProgramas catalogo_;        // cada programa distinto, una sola vez
+    std::vector<IdPrograma> programas_;
 };
 
 #endif // INSTRUCCIONES_H
@@ -0,0 +1,67 @@
+
+/**
+ * @file jit.h
+ * @brief Compilación a código nativo x86-64 de los programas más ejecutados (nivel JIT).
+ *
+ * Con --jit el motor decodificado cuenta las instrucciones que interpreta de cada proceso;
+ * al superar el umbral, el planificador compila su programa a código máquina en un buffer
+ * mmap (escrito y luego protegido como solo lectura/ejecución).
+ *
+ * Se compilan ADD/SUB/MUL/INC/JMP/NOP (y las desconocidas, que son NOP); AX/BX/CX viven en
+ * r8/r9/r10 mientras corre el código. IO, SLEEP, LOAD, STORE e INVALIDA no se compilan:
+ * el código nativo sale justo antes de ellas y el intérprete las ejecuta.
+ *
+ * Presupuesto: se llama con las instrucciones que quedan de la rebanada (quantum y tope).
+ * Desde cada punto de entrada y cada destino de JMP el código recorre un tramo recto de
+ * longitud conocida al compilar (hasta el siguiente JMP inclusive o la siguiente instrucción
+ * no compilada), así que el presupuesto se verifica y descuenta una sola vez por tramo, en
+ * la entrada y en los saltos hacia atrás. Si el tramo no entra en lo que queda, el código
+ * sale con el PC exacto de ese tramo y el intérprete termina la rebanada instrucción a
+ * instrucción: los cortes de quantum, PC y registros son idénticos a los del intérprete.
+ *
+ * Solo hay código nativo en x86-64 Linux y con aritmética envolvente (SIM_SATURAR=0); en
+ * otro caso compilarNativo retorna nulo y todo sigue interpretado. Con observador de
+ * eventos (trazas, diferencial) no se usa, porque no emite un evento por instrucción.
+ */
+
+ /**
+    * @brief Compila un programa decodificado a código nativo.
+    * @param prog Programa (con los JMP ya acotados por decodificarPrograma).
+    * @return Código listo para ejecutar, o nulo si no hay soporte o nada que compilar.
+    */
+#ifndef JIT_H
+#define JIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "proceso.h"
+#include "programa.h"
+
+class CodigoNativo {
+public:
+    CodigoNativo(void* base, size_t tam, std::vector<int32_t> entradas);
+    ~CodigoNativo();
+    CodigoNativo(const CodigoNativo&) = delete;
+    CodigoNativo& operator=(const CodigoNativo&) = delete;
+
+    // true si la instrucción en pc está compilada (se puede entrar ahí)
+    bool entrada(int pc) const { return entradas_[pc] >= 0; }
+
+    // Ejecuta desde p.pc a lo sumo 'presupuesto' instrucciones; actualiza PC y registros.
+    // Retorna las ejecutadas (0 si el primer tramo no entra en el presupuesto).
+    long long ejecutar(Proceso& p, long long presupuesto) const;
+
+private:
+    void* base_;
+    size_t tam_;
+    std::vector<int32_t> entradas_;   // desplazamiento de la entrada de cada PC; -1 = no compilada
+};
+
+// Hay generador de código para esta plataforma y esta aritmética de registros
+bool jitDisponible();
+
+std::unique_ptr<CodigoNativo> compilarNativo(const Programa& prog);
+
+#endif // JIT_H
@@ -0,0 +1,131 @@
+
+/**
+ * @file memoria.h
+ * @brief Declaración del subsistema de memoria virtual paginada del simulador.
+ *
+ * Cada proceso tiene su propio espacio de direcciones virtual (en palabras) dividido en
+ * páginas. Las páginas se ubican bajo demanda en un conjunto fijo de marcos físicos,
+ * pasando por una TLB totalmente asociativa que se vacía en cada cambio de contexto.
+ * Cuando no quedan marcos libres se elige una víctima con la política configurada
+ * (FIFO, LRU o Clock); las páginas expulsadas se guardan en un área de intercambio.
+ */
+
+ /**
+    * @class MemoriaVirtual
+    * @brief Tabla de páginas por proceso, tabla de marcos compacta, TLB y reemplazo.
+    *
+    * La tabla de marcos se guarda como arreglos paralelos (dueño, página, bits sucio/referencia)
+    * y la lista de orden FIFO/LRU es una lista doblemente enlazada sobre índices de marco,
+    * por lo que cada acceso y cada reemplazo cuestan O(1) (Clock avanza su manecilla).
+    */
+
+ /**
+    * @brief Lee la palabra de la dirección virtual indicada del proceso.
+    * @param proc Índice del proceso (posición en el vector de procesos).
+    * @param dir Dirección virtual en palabras.
+    * @param valor Valor leído (salida).
+    * @return Resultado del acceso; valido=false si la dirección está fuera del espacio virtual.
+    */
+
+ /**
+    * @brief Escribe una palabra en la dirección virtual indicada del proceso.
+    * @return Resultado del acceso; valido=false si la dirección está fuera del espacio virtual.
+    */
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "registro.h"
+
+enum class PoliticaReemplazo { FIFO, LRU, CLOCK };
+
+// Convierte "FIFO" / "LRU" / "CLOCK" (sin distinguir mayúsculas); false si no es válida
+bool parsePoliticaReemplazo(const std::string& s, PoliticaReemplazo& out);
+const char* nombrePolitica(PoliticaReemplazo p);
+
+struct ConfigMemoria {
+    int marcos = 16;              // marcos físicos disponibles
+    int tamPagina = 16;           // palabras por página
+    int paginasPorProceso = 64;   // tamaño del espacio virtual de cada proceso
+    int entradasTLB = 8;
+    PoliticaReemplazo politica = PoliticaReemplazo::LRU;
+};
+
+struct EstadisticasMemoria {
+    long long accesos = 0;
+    long long aciertosTLB = 0;
+    long long fallosTLB = 0;
+    long long fallosPagina = 0;
+    long long reemplazos = 0;
+    long long escriturasSwap = 0;   // páginas sucias expulsadas
+    long long vaciadosTLB = 0;      // = cambios de contexto del planificador
+};
+
+struct ResultadoAcceso {
+    bool valido = false;
+    bool aciertoTLB = false;
+    bool falloPagina = false;
+    int pagina = -1;
+    int marco = -1;
+};
+
+class MemoriaVirtual {
+public:
+    MemoriaVirtual(const ConfigMemoria& cfg, int nProcesos);
+
+    // Cada palabra de memoria tiene el ancho de un registro
+    ResultadoAcceso leer(int proc, long long dir, Registro& valor);
+    ResultadoAcceso escribir(int proc, long long dir, Registro valor);
+
+    // Cambia el proceso dueño de la TLB (se vacía: no hay ASID). Es el único punto que cuenta
+    // vaciados, uno por cambio de contexto del planificador.
+    void cambioContexto(int proc);
+    // Libera marcos y área de intercambio de un proceso que terminó
+    void liberarProceso(int proc);
+    // Amplía las tablas para admitir procesos con índice < nProcesos
+    void asegurarProcesos(int nProcesos);
+
+    const EstadisticasMemoria& estadisticas() const { return stats_; }
+    long long fallosPagina(int proc) const { return fallosPorProceso_[proc]; }
+    const ConfigMemoria& config() const { return cfg_; }
+
+private:
+    ResultadoAcceso traducir(int proc, long long dir, bool escritura, int& offset);
+    int obtenerMarco();             // marco libre o víctima según la política
+    void expulsar(int marco);
+    void tocar(int marco);          // registra un acceso (LRU / bit de referencia)
+    void enlazarAlFinal(int marco);
+    void desenlazar(int marco);
+    void cargarTLB(int proc);       // vacía la TLB y la asigna a proc (sin contar un vaciado)
+
+    ConfigMemoria cfg_;
+    EstadisticasMemoria stats_;
+    std::vector<long long> fallosPorProceso_;
+
+    // Tabla de páginas plana: [proc * paginasPorProceso + vpn] -> marco (-1 = no residente)
+    std::vector<int32_t> tablaPaginas_;
+
+    // Tabla de marcos (arreglos paralelos)
+    std::vector<int32_t> dueno_;    // proceso dueño (-1 = libre)
+    std::vector<int32_t> vpn_;
+    std::vector<uint8_t> sucio_;
+    std::vector<uint8_t> ref_;      // bit de referencia (Clock)
+    std::vector<int32_t> prev_, next_;  // lista FIFO/LRU; cabeza = más antiguo
+    int cabeza_ = -1, cola_ = -1;
+    int manecilla_ = 0;             // Clock
+    std::vector<int32_t> libres_;
+    std::vector<Registro> datos_;   // memoria física: marcos * tamPagina palabras
+
+    // Área de intercambio: clave proc * paginasPorProceso + vpn
+    std::unordered_map<long long, std::vector<Registro>> swap_;
+
+    // TLB totalmente asociativa del proceso en ejecución, reemplazo circular
+    int procTLB_ = -1;
+    std::vector<int32_t> tlbVpn_, tlbMarco_;
+    int tlbSiguiente_ = 0;
+};
+
+#endif // MEMORIA_H
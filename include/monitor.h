@@ -0,0 +1,88 @@
+
+/**
+ * @file monitor.h
+ * @brief Consulta en vivo del estado de una simulación por un socket Unix local.
+ *
+ * El planificador publica cada tanto una InstantaneaSimulacion (reloj lógico, largo de la
+ * cola de listos, bloqueados, admitidos, completados, instrucciones por segundo y los
+ * procesos vivos con mayor parte de la CPU). Un hilo servidor atiende el socket y, a cada
+ * conexión, responde con la última instantánea en texto "clave=valor" y cierra.
+ *
+ * Publicación sin bloqueos: triple buffer. El planificador escribe siempre en su propio
+ * buffer y lo intercambia con el del medio con un único exchange atómico; el servidor
+ * toma el del medio solo si hay uno nuevo. Ninguno espera al otro ni comparten un buffer
+ * mientras lo usan. Además toca() limita la publicación a una cada ~100 ms de tiempo real
+ * (consulta el reloj una vez cada 256 rebanadas o admisiones), así que el costo en la
+ * simulación es un contador por rebanada.
+ *
+ * Cliente: cliente/simctl.cpp (bin/simctl RUTA).
+ */
+
+ /**
+    * @brief Crea el socket en 'ruta' y arranca el hilo servidor.
+    * @return false si no se pudo crear (ruta ocupada, sin permisos o sin sockets Unix).
+    */
+#ifndef MONITOR_H
+#define MONITOR_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+constexpr int kTopMonitor = 5;
+
+struct ProcesoMonitor {
+    int pid;
+    long long cpu;                // ticks de CPU hasta ahora
+};
+
+struct InstantaneaSimulacion {
+    long long reloj = 0;
+    long long listos = 0;
+    long long bloqueados = 0;
+    long long admitidos = 0;
+    long long completados = 0;
+    long long instrucciones = 0;
+    double instrPorSegundo = 0;   // entre esta publicación y la anterior (lo calcula publicar)
+    bool terminada = false;
+    int nTop = 0;
+    ProcesoMonitor top[kTopMonitor];   // de mayor a menor CPU
+};
+
+class MonitorSimulacion {
+public:
+    MonitorSimulacion() = default;
+    ~MonitorSimulacion();
+    MonitorSimulacion(const MonitorSimulacion&) = delete;
+    MonitorSimulacion& operator=(const MonitorSimulacion&) = delete;
+
+    bool iniciar(const std::string& ruta);
+    void detener();
+
+    // Lado del planificador (un único escritor)
+    void reiniciar();                             // al empezar cada simulación
+    bool toca();                                  // true si corresponde publicar ahora
+    void publicar(InstantaneaSimulacion s);
+
+private:
+    void servir();
+    void leer(InstantaneaSimulacion& s);         // lado del servidor (un único lector)
+
+    static constexpr unsigned kNuevo = 4;         // bit "el buffer del medio no se leyó"
+    InstantaneaSimulacion buffers_[3];
+    std::atomic<unsigned> medio_{1};
+    unsigned escritura_ = 0;                      // solo el planificador
+    unsigned lectura_ = 2;                        // solo el servidor
+
+    unsigned rebanadas_ = 0;
+    std::chrono::steady_clock::time_point ultima_{};
+    long long instrAnteriores_ = 0;
+
+    std::string ruta_;
+    int fd_ = -1;
+    std::thread hilo_;
+    std::atomic<bool> salir_{false};
+};
+
+#endif // MONITOR_H
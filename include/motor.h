@@ -0,0 +1,89 @@
+
+/**
+ * @file motor.h
+ * @brief Motores de ejecución de una rebanada de CPU (quantum) de un proceso.
+ *
+ * El planificador decide QUÉ proceso corre y CUÁNDO; el motor ejecuta sus instrucciones
+ * hasta agotar el quantum, terminar el programa o bloquearse por IO/SLEEP.
+ *
+ * - Motor de REFERENCIA: interpreta el texto de cada instrucción e imprime la traza
+ *   "Instr[i] ... Quantum restante". Define la semántica oficial del simulador.
+ * - Motor DECODIFICADO: ejecuta el Programa ya decodificado (programa.h) sin analizar
+ *   cadenas ni imprimir por instrucción. Si recibe el CodigoNativo del programa (jit.h),
+ *   ejecuta en nativo los tramos compilados y solo interpreta el resto.
+ *
+ * Ambos emiten el mismo flujo de EventoTraza al observador (si hay), lo que permite
+ * compararlos paso a paso (ver diferencial.h).
+ *
+ * Los accesos a memoria pueden grabarse (registroAccesos) o tomarse de una grabación
+ * (reproducirAccesos) en lugar de la memoria virtual; así una rebanada se puede volver a
+ * ejecutar aislada para reconstruir su traza (ver bitacora.h).
+ */
+
+ /**
+    * @brief Ejecuta una rebanada con el intérprete de texto (referencia).
+    * @param p Proceso a ejecutar (se modifican PC y registros).
+    * @param idx Índice del proceso (para la memoria virtual).
+    * @param prog Líneas de texto del programa.
+    * @param st Estado compartido de la simulación (reloj, dispositivo, memoria, salida).
+    * @return Resultado de la rebanada (bloqueo o límite alcanzado).
+    */
+
+ /**
+    * @brief Ejecuta una rebanada sobre el programa decodificado.
+    * @param nativo Código nativo del programa, o nulo (no se usa si hay observador).
+    */
+#ifndef MOTOR_H
+#define MOTOR_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include "proceso.h"
+#include "programa.h"
+#include "memoria.h"
+#include "traza.h"
+#include "jit.h"
+
+// PARALELO: motor decodificado con las rebanadas de cada ronda ejecutadas en un pool de
+// hilos y fusionadas en orden Round-Robin (ver planificador.cpp)
+enum class Motor { REFERENCIA, DECODIFICADO, PARALELO };
+
+// Resultado de un LOAD/STORE tal como lo vio la rebanada (valor leído o escrito)
+struct AccesoMemoria {
+    ResultadoAcceso resultado;
+    Registro valor;
+};
+
+// Estado de la simulación visible para la CPU durante una rebanada
+struct EstadoEjecucion {
+    long long reloj = 0;              // reloj lógico (1 tick por instrucción)
+    long long dispositivoLibre = 0;   // instante en que el dispositivo de E/S queda libre
+    long long instrucciones = 0;      // total de instrucciones ejecutadas
+    long long limite = -1;            // tope de instrucciones (-1 = sin tope)
+    MemoriaVirtual* memoria = nullptr;   // nula: el motor decodificado se detiene en LOAD/STORE
+    ObservadorEventos* observador = nullptr;
+    std::ostream* out = nullptr;      // traza por instrucción (solo motor de referencia)
+    std::ostream* err = nullptr;
+    std::vector<AccesoMemoria>* registroAccesos = nullptr;  // si no es nulo, graba cada acceso
+    const AccesoMemoria* reproducirAccesos = nullptr;        // si no es nulo, reemplaza a memoria
+};
+
+struct ResultadoRebanada {
+    bool bloqueado = false;      // IO/SLEEP: el proceso espera hasta finBloqueo
+    bool porIO = false;
+    long long finBloqueo = 0;
+    bool limite = false;         // se alcanzó EstadoEjecucion::limite
+    bool requiereMemoria = false; // se detuvo ante un LOAD/STORE sin memoria (ejecución aislada)
+};
+
+ResultadoRebanada ejecutarRebanadaReferencia(Proceso& p, int idx,
+                                             const std::vector<std::string>& prog,
+                                             EstadoEjecucion& st);
+
+ResultadoRebanada ejecutarRebanadaDecodificada(Proceso& p, int idx,
+                                               const Programa& prog,
+                                               EstadoEjecucion& st,
+                                               const CodigoNativo* nativo = nullptr);
+
+#endif // MOTOR_H
@@ -12,7 +12,9 @@
     * @brief Clase que implementa el algoritmo de planificación Round Robin.
     *
     * La clase proporciona un método para planificar una lista de procesos según el algoritmo Round Robin,
-    * recibiendo las instrucciones asociadas a cada proceso.
+    * recibiendo las instrucciones asociadas a cada proceso. La simulación avanza con un reloj lógico
+    * dirigido por eventos: los procesos bloqueados por IO/SLEEP esperan en un min-heap de despertares.
+    * LOAD/STORE acceden a la memoria virtual paginada de cada proceso (ver memoria.h).
     */
 
 /**
@@ -20,6 +22,9 @@
  * 
  * @param procesos Vector de procesos a planificar. Se pasa por referencia para reflejar los cambios en el estado de los procesos.
  * @param instrucciones Vector de vectores de cadenas que representan las instrucciones asociadas a cada proceso.
+ *        Se internan en un CatalogoProgramas, así que los programas repetidos se decodifican una vez.
+ *
+ * Los procesos con Llegada > 0 se admiten en la cola de listos cuando el reloj lógico alcanza su llegada.
  */
 #ifndef PLANIFICADOR_H
 #define PLANIFICADOR_H
@@ -28,12 +33,74 @@
 #include <string>
 #include "proceso.h"
 #include "instrucciones.h"
+#include "cargador.h"
+#include "memoria.h"
+#include "motor.h"
+#include "traza.h"
+#include "bitacora.h"
+#include "catalogo.h"
+#include "monitor.h"
+
+// Modelo de costo del cambio de contexto (en ticks del reloj lógico).
+// costo = costoFijo + round(penalizacionFria * (1 - 2^(-inactivo / vidaMedia)))
+// donde 'inactivo' es el tiempo desde que el proceso entrante dejó la CPU; un proceso
+// que nunca se ejecutó paga la penalización completa (caché/TLB fríos).
+struct ConfigCambioContexto {
+    int costoFijo = 0;
+    int penalizacionFria = 0;
+    int vidaMedia = 8;
+};
+
+// Nivel de salida por consola: nada, solo el reporte final, o la traza completa
+enum class Salida { NINGUNA, RESUMEN, COMPLETA };
 
 class PlanificadorRoundRobin {
 public:
+    // Parámetros del subsistema de memoria usado por LOAD/STORE
+    void configurarMemoria(const ConfigMemoria& cfg) { cfgMemoria_ = cfg; }
+    void configurarCambioContexto(const ConfigCambioContexto& cfg) { cfgCambio_ = cfg; }
+    // Motor que ejecuta cada quantum (la traza por instrucción solo la imprime REFERENCIA)
+    void configurarMotor(Motor m) { motor_ = m; }
+    // Hilos del motor PARALELO (0 = los núcleos disponibles)
+    void configurarHilos(unsigned hilos) { hilos_ = hilos; }
+    // Motores decodificados: compila a código nativo el programa de un proceso tras
+    // interpretar 'umbral' de sus instrucciones (jit.h); -1 = nunca
+    void configurarJit(long long umbral) { jitUmbral_ = umbral; }
+    void configurarSalida(Salida s) { salida_ = s; }
+    // Recibe un EventoTraza por cada instrucción ejecutada (no toma posesión)
+    void configurarObservador(ObservadorEventos* obs) { observador_ = obs; }
+    // Tope de instrucciones ejecutadas; -1 = sin tope
+    void configurarLimite(long long limite) { limite_ = limite; }
+    // Registra un resumen por rebanada para mostrar su traza después (no toma posesión)
+    void configurarBitacora(BitacoraRebanadas* b) { bitacora_ = b; }
+    // Publica instantáneas periódicas para la consulta en vivo (no toma posesión)
+    void configurarMonitor(MonitorSimulacion* m) { monitor_ = m; }
+
     // Por referencia para que fuera de schedule se vea el estado final
     void schedule(std::vector<Proceso>& procesos,
                   const std::vector<std::vector<std::string>>& instrucciones);
+    // Igual, con los programas ya internados (un id por proceso)
+    void schedule(std::vector<Proceso>& procesos, const CatalogoProgramas& catalogo,
+                  const std::vector<IdPrograma>& programas);
+
+    // Admisión en flujo: lee cada proceso de la fuente cuando el reloj alcanza su llegada
+    // y libera su ranura al terminar (memoria proporcional a los procesos vivos)
+    void simular(FuenteProcesos& fuente);
+
+private:
+    void ejecutar(std::vector<Proceso>& procesos, const CatalogoProgramas* catalogo,
+                  const std::vector<IdPrograma>* programas, FuenteProcesos* fuente);
+
+    ConfigMemoria cfgMemoria_;
+    ConfigCambioContexto cfgCambio_;
+    Motor motor_ = Motor::REFERENCIA;
+    unsigned hilos_ = 0;
+    long long jitUmbral_ = -1;
+    Salida salida_ = Salida::COMPLETA;
+    ObservadorEventos* observador_ = nullptr;
+    long long limite_ = -1;
+    BitacoraRebanadas* bitacora_ = nullptr;
+    MonitorSimulacion* monitor_ = nullptr;
 };
 
 #endif // PLANIFICADOR_H
@@ -11,22 +11,26 @@
  * Miembros:
  * - pid:     Identificador único del proceso.
  * - pc:      Contador de programa (dirección actual de instrucción).
- * - ax:      Registro de propósito general AX.
+ * - ax:      Registro de propósito general AX (ancho según registro.h).
  * - bx:      Registro de propósito general BX.
  * - cx:      Registro de propósito general CX.
  * - quantum: Porción de tiempo asignada al proceso para su ejecución.
- * - estado:  Estado actual del proceso (por ejemplo, "ejecutando", "esperando").
+ * - llegada: Instante lógico en que el proceso entra a la cola de listos (0 por defecto).
+ * - estado:  Estado actual del proceso ("Nuevo", "Listo", "Bloqueado" o "Terminado").
  */
 #ifndef PROCESO_H
 #define PROCESO_H
 
+#include "registro.h"
+
 struct Proceso {
     int pid;
     int pc;
-    int ax;
-    int bx;
-    int cx;
+    Registro ax;
+    Registro bx;
+    Registro cx;
     int quantum;
+    int llegada;
     char estado[10];
 };
 
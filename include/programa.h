@@ -0,0 +1,48 @@
+
+/**
+ * @file programa.h
+ * @brief Representación decodificada de los programas de los procesos.
+ *
+ * Cada línea de texto se traduce una sola vez a una Instruccion compacta (opcode,
+ * registros y operando inmediato), de modo que el motor decodificado no tenga que
+ * volver a analizar cadenas en cada paso de la simulación.
+ */
+
+ /**
+    * @brief Decodifica las líneas de un programa.
+    *
+    * Replica las reglas del intérprete de referencia: un opcode desconocido se ejecuta
+    * como NOP y un operando inválido se marca como INVALIDA (el proceso cede la CPU sin
+    * avanzar el PC, igual que el intérprete de texto).
+    * @param lineas Instrucciones en texto, una por elemento.
+    * @return Programa con el código decodificado.
+    */
+#ifndef PROGRAMA_H
+#define PROGRAMA_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+enum class OpCode : uint8_t {
+    ADD, SUB, MUL, INC, JMP, NOP, IO, SLEEP, LOAD, STORE,
+    DESCONOCIDA,   // se ejecuta como NOP
+    INVALIDA       // operando inválido: el proceso cede la CPU sin avanzar
+};
+
+constexpr uint8_t kInmediato = 0xFF;   // src de una Instruccion con operando inmediato
+
+struct Instruccion {
+    OpCode op;
+    uint8_t dst;       // 0=AX, 1=BX, 2=CX
+    uint8_t src;       // registro fuente o kInmediato
+    int32_t inm;       // inmediato, destino de JMP (fin si no existe), duración o dirección
+};
+
+struct Programa {
+    std::vector<Instruccion> codigo;
+};
+
+Programa decodificarPrograma(const std::vector<std::string>& lineas);
+
+#endif // PROGRAMA_H
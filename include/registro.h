@@ -0,0 +1,69 @@
+
+/**
+ * @file registro.h
+ * @brief Ancho y aritmética de los registros AX/BX/CX, fijados al compilar.
+ *
+ * - SIM_BITS_REGISTRO: 32 o 64 (por defecto 64).
+ * - SIM_SATURAR: 0 = aritmética modular en complemento a 2 (por defecto),
+ *                1 = saturación en los extremos del tipo.
+ *
+ * ADD/SUB/MUL/INC pasan por AluRegistro, que usa __builtin_*_overflow: el resultado
+ * está definido en cualquier compilador (nunca hay desbordamiento con signo) y el caso
+ * sin desbordamiento no tiene ramas extra. Los motores se instancian con el Alu de la
+ * compilación (ver motor.cpp); las macros fijan una única configuración por binario y el
+ * Makefile recompila todo cuando cambian.
+ */
+
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#ifndef SIM_BITS_REGISTRO
+#define SIM_BITS_REGISTRO 64
+#endif
+#ifndef SIM_SATURAR
+#define SIM_SATURAR 0
+#endif
+
+static_assert(SIM_BITS_REGISTRO == 32 || SIM_BITS_REGISTRO == 64,
+              "SIM_BITS_REGISTRO debe ser 32 o 64");
+
+/**
+ * @struct AluRegistro
+ * @brief Operaciones aritméticas sobre registros de tipo T.
+ * @tparam T Tipo entero con signo del registro (int32_t o int64_t).
+ * @tparam Saturar true: el resultado se satura; false: se envuelve (módulo 2^bits).
+ */
+template <typename T, bool Saturar>
+struct AluRegistro {
+    using Tipo = T;
+    static constexpr bool kSaturar = Saturar;
+
+    static T sumar(T a, T b) {
+        T r;
+        if (__builtin_add_overflow(a, b, &r) && Saturar) return b < 0 ? minimo() : maximo();
+        return r;
+    }
+    static T restar(T a, T b) {
+        T r;
+        if (__builtin_sub_overflow(a, b, &r) && Saturar) return b < 0 ? maximo() : minimo();
+        return r;
+    }
+    static T multiplicar(T a, T b) {
+        T r;
+        if (__builtin_mul_overflow(a, b, &r) && Saturar) return (a < 0) != (b < 0) ? minimo() : maximo();
+        return r;
+    }
+
+private:
+    static constexpr T minimo() { return std::numeric_limits<T>::min(); }
+    static constexpr T maximo() { return std::numeric_limits<T>::max(); }
+};
+
+using Registro = std::conditional<SIM_BITS_REGISTRO == 64, int64_t, int32_t>::type;
+using Alu = AluRegistro<Registro, SIM_SATURAR != 0>;
+
+#endif // REGISTRO_H
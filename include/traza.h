@@ -0,0 +1,99 @@
+
+/**
+ * @file traza.h
+ * @brief Flujo de eventos de ejecución y su grabación/verificación en formato binario.
+ *
+ * Cada instrucción ejecutada produce un EventoTraza (instante, PID, PC antes y después,
+ * registros resultantes). Los motores lo entregan a un ObservadorEventos, lo que permite
+ * grabar una corrida a disco y luego reproducir otra contra ella paso a paso
+ * (reproducción determinista y pruebas diferenciales entre motores).
+ *
+ * Formato binario (little-endian):
+ *   cabecera: "SIMTRAZA" | uint32 versión (2) | uint32 bytes por registro | uint32 semántica
+ *   registros: int64 t | int32 pid | int32 pc | int32 pcDespues | ax | bx | cx
+ * Los registros ocupan 4 u 8 bytes según SIM_BITS_REGISTRO y la semántica es 0 (envolvente)
+ * o 1 (saturada); una traza solo se reproduce con un binario del mismo ancho y semántica.
+ */
+
+ /**
+    * @class GrabadorTraza
+    * @brief Observador que escribe cada evento en un archivo de traza binaria.
+    */
+
+ /**
+    * @class VerificadorTraza
+    * @brief Observador que compara cada evento con el siguiente de una traza grabada
+    * y recuerda la primera divergencia.
+    */
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <ostream>
+
+struct EventoTraza {
+    int64_t t;          // instante al terminar la instrucción
+    int32_t pid;
+    int32_t pc;         // PC antes de ejecutar
+    int32_t pcDespues;
+    int64_t ax, bx, cx; // registros después de ejecutar
+};
+
+bool operator==(const EventoTraza& a, const EventoTraza& b);
+std::ostream& operator<<(std::ostream& os, const EventoTraza& ev);
+
+class ObservadorEventos {
+public:
+    virtual ~ObservadorEventos() = default;
+    virtual void instruccion(const EventoTraza& ev) = 0;
+};
+
+class GrabadorTraza : public ObservadorEventos {
+public:
+    ~GrabadorTraza() override;
+    bool abrir(const std::string& ruta);
+    bool abrir(std::FILE* f);              // no toma posesión de f
+    void instruccion(const EventoTraza& ev) override;
+    void cerrar();
+    long long eventos() const { return n_; }
+
+private:
+    std::FILE* f_ = nullptr;
+    bool propio_ = false;
+    long long n_ = 0;
+};
+
+class VerificadorTraza : public ObservadorEventos {
+public:
+    ~VerificadorTraza() override;
+    bool abrir(const std::string& ruta);
+    bool abrir(std::FILE* f);              // no toma posesión de f
+    void instruccion(const EventoTraza& ev) override;
+    // Llamar al final de la corrida: detecta eventos grabados que no se reprodujeron
+    void terminar();
+
+    bool divergencia() const { return diverge_; }
+    long long indice() const { return n_; }
+    const EventoTraza& esperado() const { return esperado_; }
+    const EventoTraza& obtenido() const { return obtenido_; }
+    bool faltanteEsperado() const { return finEsperado_; }   // la grabación terminó antes
+    bool faltanteObtenido() const { return finObtenido_; }   // la corrida terminó antes
+    // Motivo por el que abrir() rechazó la traza (vacío si se abrió bien)
+    const std::string& motivo() const { return motivo_; }
+
+private:
+    bool leer(EventoTraza& ev);
+
+    std::FILE* f_ = nullptr;
+    bool propio_ = false;
+    long long n_ = 0;
+    bool diverge_ = false;
+    bool finEsperado_ = false;
+    bool finObtenido_ = false;
+    EventoTraza esperado_{}, obtenido_{};
+    std::string motivo_;
+};
+
+#endif // TRAZA_H
@@ -0,0 +1,107 @@
+
+/**
+ * @file analisis.cpp
+ * @brief Implementación del análisis estático: grafo funcional, alcanzabilidad y longitudes.
+ *
+ * Las longitudes (ráfaga y restantes) se calculan con un recorrido iterativo por cadenas:
+ * se sigue el sucesor hasta un caso base o un nodo ya resuelto y se resuelve la pila al
+ * volver. Si la cadena vuelve sobre sí misma sin pasar por un caso base, todos los nodos
+ * de la pila quedan en -1 (el ciclo nunca llega a la parada). Cada nodo se visita una vez.
+ */
+#include "analisis.h"
+
+// Longitud desde cada PC hasta una parada, contando la instrucción de parada.
+// parada(i): la instrucción i termina el recorrido; i == n (fin) también lo termina.
+template <typename Parada>
+static std::vector<long long> longitudes(const Programa& prog, const std::vector<int32_t>& suc,
+                                         Parada parada) {
+    const int n = static_cast<int>(prog.codigo.size());
+    std::vector<long long> lon(n, 0);
+    std::vector<uint8_t> estado(n, 0);   // 0 = sin ver, 1 = en la pila actual, 2 = resuelto
+    std::vector<int> pila;
+    // Caso base: se resuelve sin mirar al sucesor
+    auto base = [&](int i) -> long long {
+        if (prog.codigo[i].op == OpCode::INVALIDA) return -1;   // no avanza nunca
+        if (parada(i)) return 1;
+        if (suc[i] == i) return -1;                             // JMP a sí mismo
+        return 0;
+    };
+    for (int inicio = 0; inicio < n; ++inicio) {
+        int i = inicio;
+        while (i < n && estado[i] == 0) {
+            estado[i] = 1;
+            pila.push_back(i);
+            if (base(i) != 0) break;
+            i = suc[i];
+        }
+        // Valor del sucesor del tope: fin (0), nodo ya resuelto, o ciclo sin parada (-1)
+        long long v = 0;
+        if (i < n) v = estado[i] == 2 ? lon[i] : -1;
+        while (!pila.empty()) {
+            const int k = pila.back();
+            pila.pop_back();
+            const long long b = base(k);
+            v = b != 0 ? b : (v < 0 ? -1 : v + 1);
+            lon[k] = v;
+            estado[k] = 2;
+        }
+    }
+    return lon;
+}
+
+AnalisisPrograma analizarPrograma(const Programa& prog) {
+    AnalisisPrograma a;
+    const int n = static_cast<int>(prog.codigo.size());
+    a.sucesor.resize(n);
+    for (int i = 0; i < n; ++i) {
+        const Instruccion& ins = prog.codigo[i];
+        if (ins.op == OpCode::JMP) {
+            a.sucesor[i] = ins.inm;
+            if (ins.inm >= n) a.saltosFueraDeRango.push_back(i);
+            else if (ins.inm == i) a.saltosASiMismo.push_back(i);
+        } else {
+            a.sucesor[i] = i + 1;
+        }
+    }
+
+    // Camino desde la instrucción 0 (cada nodo tiene un único sucesor)
+    a.alcanzable.assign(n, 0);
+    for (int i = 0; i < n && !a.alcanzable[i]; i = a.sucesor[i]) {
+        a.alcanzable[i] = 1;
+        if (prog.codigo[i].op == OpCode::INVALIDA) break;
+    }
+    for (int i = 0; i < n; ++i)
+        if (!a.alcanzable[i]) a.muertas.push_back(i);
+
+    a.rafaga = longitudes(prog, a.sucesor, [&](int i) {
+        return prog.codigo[i].op == OpCode::IO || prog.codigo[i].op == OpCode::SLEEP;
+    });
+    a.restantes = longitudes(prog, a.sucesor, [&](int i) { return a.sucesor[i] >= n; });
+    a.instrucciones = n == 0 ? 0 : a.restantes[0];
+    return a;
+}
+
+int reportarAnalisis(std::ostream& os, const AnalisisPrograma& a, const std::string& nombre) {
+    int avisos = 0;
+    const int n = static_cast<int>(a.sucesor.size());
+    for (int i : a.saltosFueraDeRango) {
+        os << "Aviso en " << nombre << ": Instr[" << i << "] JMP fuera de rango (el programa tiene "
+           << n << " instrucciones); el proceso terminara ahi\n";
+        avisos++;
+    }
+    for (int i : a.saltosASiMismo) {
+        os << "Aviso en " << nombre << ": Instr[" << i << "] JMP a si mismo (bucle sin efecto)\n";
+        avisos++;
+    }
+    // Código muerto agrupado en rangos consecutivos
+    for (size_t k = 0; k < a.muertas.size();) {
+        size_t j = k;
+        while (j + 1 < a.muertas.size() && a.muertas[j + 1] == a.muertas[j] + 1) ++j;
+        os << "Aviso en " << nombre << ": codigo muerto en Instr[" << a.muertas[k];
+        if (j > k) os << ".." << a.muertas[j];
+        os << "] (nunca se ejecuta)\n";
+        avisos++;
+        k = j + 1;
+    }
+    return avisos;
+}
@@ -0,0 +1,137 @@
+
+/**
+ * @file bitacora.cpp
+ * @brief Implementación de la bitácora de rebanadas y de su re-ejecución para mostrar trazas.
+ *
+ * Registrar una rebanada cuesta un ResumenRebanada (más un AccesoMemoria por cada LOAD/STORE).
+ * Para mostrar una rebanada se recorre la bitácora en orden acumulando las variaciones de
+ * registros de cada proceso, se arma un Proceso con el estado de inicio y se ejecuta con
+ * ejecutarRebanadaReferencia sin memoria virtual: los accesos salen de la grabación.
+ */
+#include "bitacora.h"
+#include <algorithm>
+#include <type_traits>
+
+using RegistroSinSigno = std::make_unsigned<Registro>::type;
+
+static void printSeparator(std::ostream& os, char ch='=', int n=60) {
+    for (int i=0;i<n;++i) os << ch;
+    os << "\n";
+}
+
+// Diferencia y suma en módulo 2^bits (sin desbordamiento con signo)
+static Registro delta(Registro antes, Registro despues) {
+    return static_cast<Registro>(static_cast<RegistroSinSigno>(despues) -
+                                 static_cast<RegistroSinSigno>(antes));
+}
+static Registro aplicar(Registro r, Registro d) {
+    return static_cast<Registro>(static_cast<RegistroSinSigno>(r) +
+                                 static_cast<RegistroSinSigno>(d));
+}
+
+int BitacoraRebanadas::registrarProceso(const Proceso& p, const std::vector<std::string>& programa) {
+    // Los programas repetidos se guardan una vez (la bitácora sobrevive al catálogo en flujo)
+    const uint64_t hash = hashPrograma(programa);
+    int indice = -1;
+    auto rango = indicePrograma_.equal_range(hash);
+    for (auto it = rango.first; it != rango.second && indice < 0; ++it)
+        if (programas_[it->second] == programa) indice = it->second;
+    if (indice < 0) {
+        indice = static_cast<int>(programas_.size());
+        programas_.push_back(programa);
+        indicePrograma_.emplace(hash, indice);
+    }
+    procesos_.push_back({p.pid, p.quantum, p.ax, p.bx, p.cx, indice});
+    return static_cast<int>(procesos_.size()) - 1;
+}
+
+void BitacoraRebanadas::iniciarRebanada(int proceso, const Proceso& p, EstadoEjecucion& st) {
+    inicio_ = p;
+    instrInicio_ = st.instrucciones;
+    ResumenRebanada r{};
+    r.inicio = st.reloj;
+    r.dispositivoLibre = st.dispositivoLibre;
+    r.proceso = proceso;
+    r.pcInicio = p.pc;
+    r.primerAcceso = accesos_.size();
+    rebanadas_.push_back(r);
+    st.registroAccesos = &accesos_;
+}
+
+void BitacoraRebanadas::terminarRebanada(const Proceso& p, EstadoEjecucion& st, bool cortada) {
+    ResumenRebanada& r = rebanadas_.back();
+    r.instrucciones = static_cast<int32_t>(st.instrucciones - instrInicio_);
+    r.cortada = cortada;
+    r.dax = delta(inicio_.ax, p.ax);
+    r.dbx = delta(inicio_.bx, p.bx);
+    r.dcx = delta(inicio_.cx, p.cx);
+    r.nAccesos = static_cast<uint32_t>(accesos_.size() - r.primerAcceso);
+    st.registroAccesos = nullptr;
+}
+
+void BitacoraRebanadas::imprimirResumen(std::ostream& os) const {
+    os << "\nBITACORA DE REBANADAS (" << rebanadas_.size() << ")\n";
+    printSeparator(os, '-');
+    for (size_t k = 0; k < rebanadas_.size(); ++k) {
+        const ResumenRebanada& r = rebanadas_[k];
+        os << "  #" << k + 1 << " | t=" << r.inicio << " | P" << procesos_[r.proceso].pid
+           << " | PC=" << r.pcInicio << " | Instr=" << r.instrucciones
+           << " | dAX=" << r.dax << " | dBX=" << r.dbx << " | dCX=" << r.dcx;
+        if (r.nAccesos > 0) os << " | Accesos=" << r.nAccesos;
+        if (r.cortada) os << " | (tope)";
+        os << "\n";
+    }
+    printSeparator(os, '-');
+}
+
+long long BitacoraRebanadas::renderizar(std::ostream& os, long long desde, long long hasta,
+                                        int pid) const {
+    // Registros actuales de cada proceso, reconstruidos rebanada a rebanada
+    std::vector<Proceso> estado(procesos_.size());
+    for (size_t i = 0; i < procesos_.size(); ++i) {
+        Proceso& p = estado[i];
+        p = Proceso{};
+        p.pid = procesos_[i].pid;
+        p.quantum = procesos_[i].quantum;
+        p.ax = procesos_[i].ax;
+        p.bx = procesos_[i].bx;
+        p.cx = procesos_[i].cx;
+    }
+
+    const long long ultima = hasta < 0 ? static_cast<long long>(rebanadas_.size())
+                                       : std::min<long long>(hasta, rebanadas_.size());
+    long long mostradas = 0;
+    for (long long k = 1; k <= ultima; ++k) {
+        const ResumenRebanada& r = rebanadas_[k - 1];
+        Proceso& p = estado[r.proceso];
+        if (k >= desde && (pid < 0 || p.pid == pid)) {
+            Proceso q = p;
+            q.pc = r.pcInicio;
+            printSeparator(os, '.');
+            os << "EJECUTANDO PROCESO " << q.pid << " | "
+               << "t=" << r.inicio
+               << " | PC=" << q.pc
+               << " | AX=" << q.ax
+               << " | BX=" << q.bx
+               << " | CX=" << q.cx
+               << " | Q=" << q.quantum
+               << " | Rebanada #" << k << "\n";
+            printSeparator(os, '.');
+
+            EstadoEjecucion st;
+            st.reloj = r.inicio;
+            st.dispositivoLibre = r.dispositivoLibre;
+            st.limite = r.cortada ? r.instrucciones : -1;
+            st.out = &os;
+            st.err = &os;
+            st.reproducirAccesos = accesos_.data() + r.primerAcceso;
+            ejecutarRebanadaReferencia(q, r.proceso, programas_[procesos_[r.proceso].programa], st);
+            os << "\n";
+            mostradas++;
+        }
+        p.ax = aplicar(p.ax, r.dax);
+        p.bx = aplicar(p.bx, r.dbx);
+        p.cx = aplicar(p.cx, r.dcx);
+    }
+    return mostradas;
+}
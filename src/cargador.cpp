@@ -5,8 +5,10 @@
  *
  * Este archivo contiene la lógica para cargar procesos desde un archivo o desde la consola,
  * validando la sintaxis de cada línea según la gramática definida:
- *   PID: <num> [, AX=<num>][, BX=<num>][, CX=<num>] , Quantum=<num>
- * 
+ *   PID: <num> [, AX=<num>][, BX=<num>][, CX=<num>] , Quantum=<num> [, Llegada=<num>]
+ *
+ * Llegada es el instante lógico en que el proceso entra a la cola de listos (0 si se omite).
+ *
  * Funcionalidades principales:
  * - Validación y parseo de líneas de procesos usando expresiones regulares.
  * - Carga de procesos desde archivo o entrada estándar.
@@ -18,23 +20,50 @@
  *   - bool cargarProcesos(const std::string& filename): Carga procesos desde un archivo.
  *   - bool cargarProcesosDesdeConsola(): Carga procesos desde la entrada estándar.
  *   - const std::vector<Proceso>& getProcesos() const: Acceso a los procesos cargados.
+ * - CargadorProcesosFlujo: Fuente perezosa para la admisión en flujo; lee una línea y su
+ *   programa (instr/<PID>.txt) solo cuando el planificador pide el siguiente proceso.
  * - parseLineaProceso: Función auxiliar para parsear y validar una línea de proceso.
  *
  * @author
  * @date
  */
 #include "cargador.h"
+#include "instrucciones.h"
+#include "entrada.h"
 #include <fstream>
 #include <iostream>
 #include <regex>
 #include <cstring> 
+#include <limits>
+#include <stdexcept>
 
-// Gramática: PID: <num> [, AX=<num>][, BX=<num>][, CX=<num>] , Quantum=<num>
+// Gramática: PID: <num> [, AX=<num>][, BX=<num>][, CX=<num>] , Quantum=<num> [, Llegada=<num>]
 static const std::regex kProcRegex(
-    R"(^(?:\s*)PID:\s*(\d+)((?:,\s*(AX|BX|CX)=\d+)*)\s*,\s*Quantum=(\d+)\s*$)"
+    R"(^(?:\s*)PID:\s*(\d+)((?:,\s*(AX|BX|CX)=\d+)*)\s*,\s*Quantum=(\d+)(?:\s*,\s*Llegada=(\d+))?\s*$)"
 );
+static const std::regex kRegsRegex("(AX|BX|CX)=(\\d+)");
 
-static void parseLineaProceso(const std::string& line, std::vector<Proceso>& out, int lineNum=-1) {
+// Convierte un número ya validado por la regex; si no cabe en 'maximo' (o en long long)
+// se informa como los demás errores de la línea
+static long long campoNumerico(const std::string& valor, const std::string& campo, long long maximo,
+                               const std::string& limite, const std::string& line, int lineNum) {
+    long long v = 0;
+    bool cabe = true;
+    try {
+        v = std::stoll(valor);
+        cabe = v <= maximo;
+    } catch (const std::out_of_range&) {
+        cabe = false;
+    }
+    if (!cabe) {
+        std::cerr << "Valor fuera de rango para " << campo << " (" << limite << ")"
+                  << (lineNum>=0? " en línea "+std::to_string(lineNum):"") << ": " << line << "\n";
+        throw std::runtime_error("Linea invalida");
+    }
+    return v;
+}
+
+static Proceso parseLineaProceso(const std::string& line, int lineNum=-1) {
     std::smatch m;
     if (!std::regex_match(line, m, kProcRegex)) {
         std::cerr << "Error de sintaxis" << (lineNum>=0? " en línea "+std::to_string(lineNum):"")
@@ -42,25 +71,32 @@ static void parseLineaProceso(const std::string& line, std::vector<Proceso>& out
         throw std::runtime_error("Linea invalida");
     }
 
+    const long long maxInt = std::numeric_limits<int>::max();
+    const std::string limiteInt = "máximo " + std::to_string(maxInt);
     Proceso p{};
-    p.pid = std::stoi(m[1].str());
+    p.pid = static_cast<int>(campoNumerico(m[1].str(), "PID", maxInt, limiteInt, line, lineNum));
     p.pc = 0;
     p.ax = p.bx = p.cx = 0;
-    p.quantum = std::stoi(m[4].str());
+    p.quantum = static_cast<int>(campoNumerico(m[4].str(), "Quantum", maxInt, limiteInt, line, lineNum));
+    p.llegada = m[5].matched
+        ? static_cast<int>(campoNumerico(m[5].str(), "Llegada", maxInt, limiteInt, line, lineNum))
+        : 0;
 
     const std::string regs = m[2].str();
-    std::regex rgxRegs("(AX|BX|CX)=(\\d+)");
-    for (auto it = std::sregex_iterator(regs.begin(), regs.end(), rgxRegs);
+    for (auto it = std::sregex_iterator(regs.begin(), regs.end(), kRegsRegex);
          it != std::sregex_iterator(); ++it) {
         std::string r = (*it)[1].str();
-        int v = std::stoi((*it)[2].str());
+        // límite del ancho de registro: un valor que no cabe es error de la línea
+        Registro v = static_cast<Registro>(campoNumerico(
+            (*it)[2].str(), r, std::numeric_limits<Registro>::max(),
+            "registros de " + std::to_string(SIM_BITS_REGISTRO) + " bits", line, lineNum));
         if (r == "AX") p.ax = v;
         else if (r == "BX") p.bx = v;
         else if (r == "CX") p.cx = v;
     }
 
     std::strcpy(p.estado, "Listo");
-    out.push_back(p);
+    return p;
 }
 
 bool CargadorProcesos::cargarProcesos(const std::string& filename) {
@@ -76,7 +112,7 @@ bool CargadorProcesos::cargarProcesos(const std::string& filename) {
         while (std::getline(file, line)) {
             ++lineNum;
             if (line.empty()) continue;
-            parseLineaProceso(line, procesos_, lineNum);
+            procesos_.push_back(parseLineaProceso(line, lineNum));
         }
     } catch (...) {
         procesos_.clear();
@@ -87,20 +123,23 @@ bool CargadorProcesos::cargarProcesos(const std::string& filename) {
 
 bool CargadorProcesos::cargarProcesosDesdeConsola() {
     procesos_.clear();
-    std::cout << "Ingrese procesos (una línea por proceso). Ejemplos:\n";
-    std::cout << "  PID: 1, AX=5, BX=3, Quantum=2\n";
-    std::cout << "  PID: 2, CX=7, Quantum=3\n";
-    std::cout << "Finalice con una línea vacía.\n\n";
+    const bool avisos = entradaInteractiva();   // sin terminal (pipe) no se muestran avisos
+    if (avisos) {
+        std::cout << "Ingrese procesos (una línea por proceso). Ejemplos:\n";
+        std::cout << "  PID: 1, AX=5, BX=3, Quantum=2\n";
+        std::cout << "  PID: 2, CX=7, Quantum=3\n";
+        std::cout << "Finalice con una línea vacía.\n\n";
+    }
 
     std::string line;
     int lineNum = 0;
     try {
         while (true) {
-            std::cout << "> ";
-            std::getline(std::cin, line);
+            if (avisos) std::cout << "> ";
+            leerLineaEntrada(line);
             if (line.empty()) break;
             ++lineNum;
-            parseLineaProceso(line, procesos_, lineNum);
+            procesos_.push_back(parseLineaProceso(line, lineNum));
         }
     } catch (...) {
         procesos_.clear();
@@ -117,3 +156,64 @@ const std::vector<Proceso>& CargadorProcesos::getProcesos() const {
     return procesos_;
 }
 
+
+bool CargadorProcesosFlujo::abrir(const std::string& filename, const std::string& instrDir) {
+    instrDir_ = instrDir;
+    lineNum_ = 0;
+    ultimaLlegada_ = 0;
+    leidos_ = 0;
+    lineaError_ = 0;
+    error_ = false;
+    if (filename == "-") {
+        in_ = nullptr;
+        consola_ = true;
+        return true;
+    }
+    consola_ = false;
+    archivo_.open(filename);
+    if (!archivo_) {
+        std::cerr << "Error: no se pudo abrir " << filename << "\n";
+        in_ = nullptr;
+        return false;
+    }
+    in_ = &archivo_;
+    return true;
+}
+
+bool CargadorProcesosFlujo::siguiente(Proceso& p, CatalogoProgramas& catalogo,
+                                      IdPrograma& programa) {
+    if ((!in_ && !consola_) || error_) return false;
+    std::string line;
+    while (consola_ ? leerLineaEntrada(line) : static_cast<bool>(std::getline(*in_, line))) {
+        ++lineNum_;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        try {
+            p = parseLineaProceso(line, lineNum_);
+        } catch (...) {
+            error_ = true;
+            lineaError_ = lineNum_;
+            return false;
+        }
+        if (p.llegada < ultimaLlegada_) {
+            std::cerr << "Aviso (línea " << lineNum_ << "): Llegada=" << p.llegada
+                      << " menor que la anterior; se usa " << ultimaLlegada_ << "\n";
+            p.llegada = ultimaLlegada_;
+        }
+        ultimaLlegada_ = p.llegada;
+        const std::string path = instrDir_ + "/" + std::to_string(p.pid) + ".txt";
+        if (!cargarProgramaArchivo(path, catalogo, programa)) {
+            error_ = true;
+            lineaError_ = lineNum_;
+            return false;
+        }
+        ++leidos_;
+        return true;
+    }
+    return false;
+}
+
+std::string CargadorProcesosFlujo::interrupcion() const {
+    if (!error_) return "";
+    return "error en la linea " + std::to_string(lineaError_) + " de la entrada; se admitieron "
+         + std::to_string(leidos_) + " procesos y el resto no se leyo";
+}
@@ -0,0 +1,57 @@
+
+/**
+ * @file catalogo.cpp
+ * @brief Implementación del catálogo de programas internados.
+ */
+#include "catalogo.h"
+
+uint64_t hashPrograma(const std::vector<std::string>& lineas) {
+    uint64_t h = 1469598103934665603ull;
+    auto mezclar = [&h](unsigned char c) { h = (h ^ c) * 1099511628211ull; };
+    for (const std::string& l : lineas) {
+        for (unsigned char c : l) mezclar(c);
+        mezclar('\n');   // separa "AB","C" de "A","BC"
+    }
+    return h;
+}
+
+IdPrograma CatalogoProgramas::retener(const std::vector<std::string>& lineas, uint64_t hash) {
+    auto rango = indice_.equal_range(hash);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        Entrada& e = entradas_[it->second];
+        if (e.texto == lineas) {
+            e.referencias++;
+            return it->second;
+        }
+    }
+    return -1;
+}
+
+IdPrograma CatalogoProgramas::internar(const std::vector<std::string>& lineas, bool* nuevo) {
+    const uint64_t hash = hashPrograma(lineas);
+    IdPrograma id = retener(lineas, hash);
+    if (nuevo) *nuevo = (id < 0);
+    if (id >= 0) return id;
+
+    if (!libres_.empty()) { id = libres_.back(); libres_.pop_back(); }
+    else { id = static_cast<IdPrograma>(entradas_.size()); entradas_.emplace_back(); }
+    Entrada& e = entradas_[id];
+    e.hash = hash;
+    e.referencias = 1;
+    e.texto = lineas;
+    e.programa = decodificarPrograma(lineas);
+    e.analisis = analizarPrograma(e.programa);
+    indice_.emplace(hash, id);
+    return id;
+}
+
+bool CatalogoProgramas::liberar(IdPrograma id) {
+    Entrada& e = entradas_[id];
+    if (--e.referencias > 0) return false;
+    auto rango = indice_.equal_range(e.hash);
+    for (auto it = rango.first; it != rango.second; ++it)
+        if (it->second == id) { indice_.erase(it); break; }
+    e = Entrada{};   // devuelve la memoria del texto, el código y el análisis
+    libres_.push_back(id);
+    return true;
+}
@@ -0,0 +1,238 @@
+
+/**
+ * @file diferencial.cpp
+ * @brief Implementación del arnés diferencial referencia vs. motor decodificado.
+ *
+ * Para cada carga:
+ * 1) Se generan procesos y programas (sin pasar por el validador, para poder incluir
+ *    opcodes desconocidos, saltos fuera de rango y operandos inválidos).
+ * 2) Se ejecuta el motor de REFERENCIA grabando sus eventos en un archivo temporal.
+ * 3) Se ejecuta el motor DECODIFICADO con un VerificadorTraza sobre esa grabación.
+ * 4) Se comparan los estados finales de los procesos.
+ * 5) Con cfg.jit >= 0, se ejecuta el motor con JIT sin observador y su reporte final se
+ *    compara con el de la referencia (capturado de std::cout en la corrida del paso 2).
+ *
+ * Los inmediatos grandes ocasionales fuerzan desbordes en ADD/SUB/MUL, de modo que también
+ * se compara la semántica envolvente/saturada de ambos motores.
+ */
+#include "diferencial.h"
+#include "jit.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const char* kRegs[3] = {"AX", "BX", "CX"};
+
+// Formas que decodifican a INVALIDA (el proceso cede la CPU sin avanzar el PC)
+static const char* kInvalidas[] = {
+    "ADD DX, 1", "SUB AX, foo", "MUL CX,", "INC", "INC 5", "JMP x", "JMP", "jmp 1x",
+    "IO 0", "SLEEP -3", "IO", "LOAD AX", "STORE QX, 2", "ADD AX, 99999999999",
+};
+
+static void generarCarga(std::mt19937_64& rng, const ConfigDiferencial& cfg,
+                         std::vector<Proceso>& procesos,
+                         std::vector<std::vector<std::string>>& instrucciones) {
+    auto rnd = [&](int a, int b) { return std::uniform_int_distribution<int>(a, b)(rng); };
+    const int espacio = cfg.memoria.paginasPorProceso * cfg.memoria.tamPagina;
+
+    procesos.clear();
+    instrucciones.clear();
+    // Una de cada cuatro cargas incluye operandos inválidos: un proceso que llega a uno no
+    // termina nunca, así que en el resto de las cargas los procesos sí pueden terminar
+    const bool conInvalidas = rnd(0, 3) == 0;
+    const int nInvalidas = static_cast<int>(sizeof(kInvalidas) / sizeof(kInvalidas[0]));
+    for (int i = 0; i < cfg.procesos; ++i) {
+        Proceso p{};
+        p.pid = i + 1;
+        p.ax = rnd(-5, 20);
+        p.bx = rnd(-5, 20);
+        p.cx = rnd(-5, 20);
+        p.quantum = rnd(1, 5);
+        std::strcpy(p.estado, "Listo");
+        procesos.push_back(p);
+
+        const int largo = rnd(1, cfg.largo);
+        std::vector<std::string> prog;
+        for (int k = 0; k < largo; ++k) {
+            std::string r = kRegs[rnd(0, 2)];
+            std::string src = rnd(0, 1) ? std::string(kRegs[rnd(0, 2)])
+                            : std::to_string(rnd(0, 7) ? rnd(-9, 9) : rnd(-2000000000, 2000000000));  // desbordes
+            if (conInvalidas && rnd(0, 15) == 0) {
+                prog.push_back(kInvalidas[rnd(0, nInvalidas - 1)]);
+                continue;
+            }
+            switch (rnd(0, 11)) {
+                case 0: prog.push_back("ADD " + r + ", " + src); break;
+                case 1: prog.push_back("SUB " + r + ", " + src); break;
+                case 2: prog.push_back("MUL " + r + ", " + src); break;
+                case 3: prog.push_back("INC " + r); break;
+                case 4: prog.push_back("NOP"); break;
+                case 5: prog.push_back("JMP " + std::to_string(rnd(0, largo + 2))); break;  // puede salirse
+                case 6: prog.push_back(rnd(0, 1) ? "FOO" : "HALT " + r); break;            // desconocidas
+                case 7: prog.push_back("IO " + std::to_string(rnd(1, 6))); break;
+                case 8: prog.push_back("SLEEP " + std::to_string(rnd(1, 6))); break;
+                case 9: prog.push_back("LOAD " + r + ", " +
+                                       (rnd(0, 3) ? std::to_string(rnd(0, espacio + espacio / 8))
+                                                  : std::string(kRegs[rnd(0, 2)]))); break;
+                case 10: prog.push_back("STORE " + r + ", " + std::to_string(rnd(0, espacio - 1))); break;
+                default: prog.push_back(rnd(0, 1) ? "add " + r + "," + src : "  inc " + r + "  "); break;
+            }
+        }
+        instrucciones.push_back(prog);
+    }
+}
+
+static void imprimirCarga(std::ostream& os, const std::vector<Proceso>& procesos,
+                          const std::vector<std::vector<std::string>>& instrucciones) {
+    for (size_t i = 0; i < procesos.size(); ++i) {
+        const Proceso& p = procesos[i];
+        os << "  PID: " << p.pid << ", AX=" << p.ax << ", BX=" << p.bx << ", CX=" << p.cx
+           << ", Quantum=" << p.quantum << "\n";
+        for (size_t k = 0; k < instrucciones[i].size(); ++k)
+            os << "    [" << k << "] " << instrucciones[i][k] << "\n";
+    }
+}
+
+static bool mismoEstado(const Proceso& a, const Proceso& b) {
+    return a.pid == b.pid && a.pc == b.pc && a.ax == b.ax && a.bx == b.bx && a.cx == b.cx
+        && std::strcmp(a.estado, b.estado) == 0;
+}
+
+static void configurar(PlanificadorRoundRobin& rr, const ConfigDiferencial& cfg, Motor m,
+                       ObservadorEventos* obs) {
+    rr.configurarMemoria(cfg.memoria);
+    rr.configurarCambioContexto(cfg.cambio);
+    rr.configurarMotor(m);
+    rr.configurarHilos(cfg.hilos);
+    rr.configurarSalida(Salida::NINGUNA);
+    rr.configurarObservador(obs);
+    rr.configurarLimite(cfg.limite);
+}
+
+// Ejecuta la simulación con el reporte final (Salida::RESUMEN) capturado en 'reporte'
+static void simularConReporte(PlanificadorRoundRobin& rr, std::vector<Proceso>& procesos,
+                              const std::vector<std::vector<std::string>>& instrucciones,
+                              std::string& reporte) {
+    std::ostringstream captura;
+    std::streambuf* anterior = std::cout.rdbuf(captura.rdbuf());
+    rr.configurarSalida(Salida::RESUMEN);
+    rr.schedule(procesos, instrucciones);
+    std::cout.rdbuf(anterior);
+    reporte = captura.str();
+}
+
+// Primera línea distinta entre dos reportes (1-based); 0 si son iguales
+static int primeraLineaDistinta(const std::string& a, const std::string& b,
+                                std::string& la, std::string& lb) {
+    std::istringstream ia(a), ib(b);
+    for (int linea = 1;; ++linea) {
+        const bool hayA = static_cast<bool>(std::getline(ia, la));
+        const bool hayB = static_cast<bool>(std::getline(ib, lb));
+        if (!hayA && !hayB) return 0;
+        if (!hayA) la = "(sin mas lineas)";
+        if (!hayB) lb = "(sin mas lineas)";
+        if (!hayA || !hayB || la != lb) return linea;
+    }
+}
+
+bool ejecutarDiferencial(const ConfigDiferencial& cfg, std::ostream& os) {
+    std::vector<Proceso> inicial;
+    std::vector<std::vector<std::string>> instrucciones;
+    long long totalEventos = 0;
+    const bool conJit = cfg.jit >= 0 && cfg.motor != Motor::REFERENCIA;
+    std::string reporteRef, reporteJit;
+
+    for (int c = 0; c < cfg.cargas; ++c) {
+        const unsigned long long semilla = cfg.semilla + c;
+        std::mt19937_64 rng(semilla);
+        generarCarga(rng, cfg, inicial, instrucciones);
+
+        std::FILE* tmp = std::tmpfile();
+        if (!tmp) { os << "Error: no se pudo crear la traza temporal\n"; return false; }
+
+        std::vector<Proceso> ref = inicial;
+        GrabadorTraza grabador;
+        grabador.abrir(tmp);
+        PlanificadorRoundRobin rrRef;
+        configurar(rrRef, cfg, Motor::REFERENCIA, &grabador);
+        if (conJit) simularConReporte(rrRef, ref, instrucciones, reporteRef);
+        else rrRef.schedule(ref, instrucciones);
+        grabador.cerrar();
+        std::rewind(tmp);
+
+        std::vector<Proceso> opt = inicial;
+        VerificadorTraza verif;
+        verif.abrir(tmp);
+        PlanificadorRoundRobin rrOpt;
+        configurar(rrOpt, cfg, cfg.motor, &verif);
+        rrOpt.schedule(opt, instrucciones);
+        verif.terminar();
+        std::fclose(tmp);
+
+        int difEstado = -1;
+        for (size_t i = 0; i < ref.size() && difEstado < 0; ++i)
+            if (!mismoEstado(ref[i], opt[i])) difEstado = static_cast<int>(i);
+
+        if (verif.divergencia() || difEstado >= 0) {
+            os << "DIVERGENCIA en carga #" << c << " (semilla " << semilla << ")\n";
+            if (verif.divergencia()) {
+                os << "  Primer evento distinto: #" << verif.indice() << "\n";
+                if (verif.faltanteEsperado())
+                    os << "  Referencia: (sin mas eventos)\n";
+                else {
+                    const EventoTraza& e = verif.esperado();
+                    os << "  Referencia:  " << e;
+                    for (size_t i = 0; i < inicial.size(); ++i)
+                        if (inicial[i].pid == e.pid && e.pc < static_cast<int>(instrucciones[i].size()))
+                            os << "  | Instr[" << e.pc << "] " << instrucciones[i][e.pc];
+                    os << "\n";
+                }
+                if (verif.faltanteObtenido()) os << "  Decodificado: (sin mas eventos)\n";
+                else os << "  Decodificado: " << verif.obtenido() << "\n";
+            } else {
+                const Proceso& a = ref[difEstado];
+                const Proceso& b = opt[difEstado];
+                os << "  Estado final distinto del proceso " << a.pid << ":\n"
+                   << "  Referencia:   PC=" << a.pc << " AX=" << a.ax << " BX=" << a.bx
+                   << " CX=" << a.cx << " Estado=" << a.estado << "\n"
+                   << "  Decodificado: PC=" << b.pc << " AX=" << b.ax << " BX=" << b.bx
+                   << " CX=" << b.cx << " Estado=" << b.estado << "\n";
+            }
+            os << "  Carga:\n";
+            imprimirCarga(os, inicial, instrucciones);
+            return false;
+        }
+        totalEventos += verif.indice();
+
+        if (conJit) {
+            std::vector<Proceso> nat = inicial;
+            PlanificadorRoundRobin rrJit;
+            configurar(rrJit, cfg, cfg.motor, nullptr);   // sin observador: corre el nativo
+            rrJit.configurarJit(cfg.jit);
+            simularConReporte(rrJit, nat, instrucciones, reporteJit);
+            std::string la, lb;
+            const int linea = primeraLineaDistinta(reporteRef, reporteJit, la, lb);
+            if (linea > 0) {
+                os << "DIVERGENCIA JIT (umbral " << cfg.jit << ") en carga #" << c
+                   << " (semilla " << semilla << ")\n"
+                   << "  Reporte final, linea " << linea << ":\n"
+                   << "  Referencia: " << la << "\n"
+                   << "  JIT:        " << lb << "\n"
+                   << "  Carga:\n";
+                imprimirCarga(os, inicial, instrucciones);
+                return false;
+            }
+        }
+    }
+    os << "Diferencial OK: " << cfg.cargas << " cargas, " << totalEventos
+       << " eventos identicos (semillas " << cfg.semilla << ".."
+       << cfg.semilla + cfg.cargas - 1 << ")\n";
+    if (conJit)
+        os << "JIT (umbral " << cfg.jit << "): reportes finales identicos"
+           << (jitDisponible() ? "" : " (sin JIT en esta compilacion: se interpreto)") << "\n";
+    return true;
+}
@@ -0,0 +1,85 @@
+
+/**
+ * @file entrada.cpp
+ * @brief Implementación de la lectura de consola con bloques grandes para entradas no interactivas.
+ */
+#include "entrada.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__)
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+bool entradaInteractiva() {
+#if defined(__unix__)
+    static const bool tty = isatty(STDIN_FILENO) != 0;
+    return tty;
+#else
+    return true;
+#endif
+}
+
+void prepararEntrada() {
+    if (!entradaInteractiva()) std::cin.tie(nullptr);
+}
+
+#if defined(__unix__)
+
+// Bloque de lectura: [inicio, fin) aún no entregado. Se reserva en la primera lectura sin
+// terminal; una sesión interactiva nunca lo usa.
+static std::vector<char>& bloqueLectura() {
+    static std::vector<char> bloque(1 << 20);
+    return bloque;
+}
+static size_t inicio = 0, fin = 0;
+static bool agotada = false;
+
+static bool rellenar(std::vector<char>& bloque) {
+    if (agotada) return false;
+    if (inicio > 0) {   // conserva la línea incompleta al principio del bloque
+        std::memmove(bloque.data(), bloque.data() + inicio, fin - inicio);
+        fin -= inicio;
+        inicio = 0;
+    }
+    if (fin == bloque.size()) bloque.resize(bloque.size() * 2);   // línea más larga que el bloque
+    ssize_t k;
+    do {
+        k = read(STDIN_FILENO, bloque.data() + fin, bloque.size() - fin);
+    } while (k < 0 && errno == EINTR);
+    if (k <= 0) { agotada = true; return false; }
+    fin += static_cast<size_t>(k);
+    return true;
+}
+
+bool leerLineaEntrada(std::string& linea) {
+    if (entradaInteractiva()) return static_cast<bool>(std::getline(std::cin, linea));
+    std::vector<char>& bloque = bloqueLectura();
+    size_t visto = inicio;
+    while (true) {
+        const void* nl = std::memchr(bloque.data() + visto, '\n', fin - visto);
+        if (nl) {
+            const size_t pos = static_cast<const char*>(nl) - bloque.data();
+            linea.assign(bloque.data() + inicio, pos - inicio);
+            inicio = pos + 1;
+            return true;
+        }
+        visto = fin - inicio;   // posición relativa; rellenar() mueve la línea al inicio
+        if (!rellenar(bloque)) break;
+    }
+    // Última línea sin '\n' (como std::getline, se entrega igual)
+    linea.assign(bloque.data() + inicio, fin - inicio);
+    const bool hay = inicio < fin;
+    inicio = fin;
+    return hay;
+}
+
+#else
+
+bool leerLineaEntrada(std::string& linea) {
+    return static_cast<bool>(std::getline(std::cin, linea));
+}
+
+#endif
@@ -0,0 +1,61 @@
+
+/**
+ * @file hilos.cpp
+ * @brief Implementación del pool de hilos: reparto dinámico de índices con un contador atómico.
+ */
+#include "hilos.h"
+#include <algorithm>
+
+PoolHilos::PoolHilos(unsigned hilos) {
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 1; i < hilos; ++i) trabajadores_.emplace_back([this] { trabajar(); });
+}
+
+PoolHilos::~PoolHilos() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        salir_ = true;
+    }
+    hayTrabajo_.notify_all();
+    for (auto& t : trabajadores_) t.join();
+}
+
+void PoolHilos::consumir() {
+    for (size_t i = siguiente_++; i < total_; i = siguiente_++) (*tarea_)(i);
+}
+
+void PoolHilos::trabajar() {
+    unsigned long long visto = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            hayTrabajo_.wait(lk, [&] { return salir_ || lote_ != visto; });
+            if (salir_) return;
+            visto = lote_;
+        }
+        consumir();
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (--pendientes_ == 0) terminado_.notify_one();
+    }
+}
+
+void PoolHilos::paraCada(size_t n, const std::function<void(size_t)>& f) {
+    if (n == 0) return;
+    if (trabajadores_.empty() || n == 1) {
+        for (size_t i = 0; i < n; ++i) f(i);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        tarea_ = &f;
+        total_ = n;
+        siguiente_ = 0;
+        pendientes_ = trabajadores_.size();
+        lote_++;
+    }
+    hayTrabajo_.notify_all();
+    consumir();
+    std::unique_lock<std::mutex> lk(mtx_);
+    terminado_.wait(lk, [&] { return pendientes_ == 0; });
+    tarea_ = nullptr;
+}
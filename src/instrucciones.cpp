@@ -5,7 +5,7 @@
  *
  * Este archivo contiene funciones para:
  * - Eliminar espacios en blanco y convertir cadenas a mayúsculas.
- * - Validar instrucciones de un lenguaje ensamblador simple (NOP, INC, JMP, ADD, SUB, MUL).
+ * - Validar instrucciones de un lenguaje ensamblador simple (NOP, INC, JMP, ADD, SUB, MUL, IO, SLEEP, LOAD, STORE).
  * - Cargar instrucciones desde archivos o desde la consola para una lista de procesos.
  *
  * Funciones auxiliares:
@@ -14,21 +14,32 @@
  * - isReg: Verifica si una cadena representa un registro válido (AX, BX, CX).
  * - parseIntSafe: Intenta convertir una cadena a entero de forma segura.
  * - validarInstruccion: Valida la sintaxis y semántica de una instrucción individual.
+ * - cargarProgramaArchivo: Lee el programa de un proceso desde un archivo y lo interna.
+ *
+ * Los programas se internan en un CatalogoProgramas (catalogo.h). Un contenido que ya está
+ * en el catálogo no se vuelve a validar; uno nuevo se valida y se decodifica y analiza una
+ * sola vez (analisis.h avisa de JMP fuera de rango o a sí mismos y de código muerto sin
+ * rechazar la carga).
  *
  * Métodos de CargadorInstrucciones:
  * - cargarInstrucciones: Carga instrucciones desde archivos de texto, uno por proceso.
  * - cargarInstruccionesDesdeConsola: Permite ingresar instrucciones manualmente por consola.
- * - getInstrucciones: Devuelve las instrucciones cargadas para todos los procesos.
+ * - getProgramas / getCatalogo: Id del programa de cada proceso y el catálogo compartido.
  *
  * Las instrucciones válidas son:
  * - NOP: Sin operandos.
  * - INC <REG>: Incrementa el registro especificado.
  * - JMP <INT>: Salta a la línea indicada.
  * - ADD|SUB|MUL <REG>, <REG|INT>: Operaciones aritméticas entre registros o enteros.
+ * - IO <INT>: Solicita E/S al dispositivo simulado durante <INT> ticks (bloquea el proceso).
+ * - SLEEP <INT>: Bloquea el proceso durante <INT> ticks.
+ * - LOAD|STORE <REG>, <REG|INT>: Lee/escribe la palabra de memoria virtual en la dirección dada.
  *
  * Se reportan errores detallados en caso de instrucciones inválidas.
  */
 #include "instrucciones.h"
+#include "analisis.h"
+#include "entrada.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
@@ -91,6 +102,14 @@ static bool validarInstruccion(const std::string& original, std::string& error)
         if (tgt < 0) { error = "Destino JMP no puede ser negativo"; return false; }
         return true;
     }
+    if (op=="IO" || op=="SLEEP") {
+        // IO|SLEEP <INT> (duración en ticks, > 0)
+        if (rest.empty()) { error = op + " requiere duracion (entero)"; return false; }
+        int dur=0;
+        if (!parseIntSafe(rest, dur)) { error = "Duracion de " + op + " debe ser entero"; return false; }
+        if (dur <= 0) { error = "Duracion de " + op + " debe ser positiva"; return false; }
+        return true;
+    }
     if (op=="ADD" || op=="SUB" || op=="MUL") {
         // ADD|SUB|MUL <REG>, <REG|INT>
         if (rest.empty()) { error = op + " requiere 2 operandos"; return false; }
@@ -106,51 +125,88 @@ static bool validarInstruccion(const std::string& original, std::string& error)
         return true;
     }
 
+    if (op=="LOAD" || op=="STORE") {
+        // LOAD|STORE <REG>, <REG|INT> (dirección virtual en palabras)
+        if (rest.empty()) { error = op + " requiere 2 operandos"; return false; }
+        size_t cpos = rest.find(',');
+        if (cpos == std::string::npos) { error = op + " requiere coma entre operandos"; return false; }
+        std::string a1 = trim(rest.substr(0,cpos));
+        std::string a2 = trim(rest.substr(cpos+1));
+        if (!isReg(a1)) { error = "Registro de " + op + " debe ser AX/BX/CX"; return false; }
+        if (!isReg(a2)) {
+            int dir=0;
+            if (!parseIntSafe(a2, dir)) { error = "Direccion debe ser AX/BX/CX o entero"; return false; }
+            if (dir < 0) { error = "Direccion no puede ser negativa"; return false; }
+        }
+        return true;
+    }
+
     error = "Instruccion no permitida: " + op;
     return false;
 }
 
+bool cargarProgramaArchivo(const std::string& path, CatalogoProgramas& catalogo, IdPrograma& id) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: no se encontró " << path << "\n";
+        return false;
+    }
+    std::vector<std::string> lista;
+    std::vector<int> numeros;   // línea del archivo de cada instrucción (para los errores)
+    std::string line;
+    int lineNum = 0;
+    while (std::getline(file, line)) {
+        ++lineNum;
+        if (trim(line).empty()) continue; // ignorar líneas vacías
+        lista.push_back(line);
+        numeros.push_back(lineNum);
+    }
+    id = catalogo.retener(lista, hashPrograma(lista));
+    if (id >= 0) return true;     // contenido ya validado y analizado
+    for (size_t k = 0; k < lista.size(); ++k) {
+        std::string err;
+        if (!validarInstruccion(lista[k], err)) {
+            std::cerr << "Error en " << path << " (linea " << numeros[k] << "): " << err
+                      << " | Texto: " << lista[k] << "\n";
+            return false;
+        }
+    }
+    id = catalogo.internar(lista);
+    reportarAnalisis(std::cerr, catalogo.analisis(id), path);
+    return true;
+}
+
 bool CargadorInstrucciones::cargarInstrucciones(const std::string& instrDir,
                                                 const std::vector<Proceso>& procesos) {
-    instrucciones_.clear();
+    catalogo_ = CatalogoProgramas();
+    programas_.clear();
     for (const auto& p : procesos) {
         std::string path = instrDir + "/" + std::to_string(p.pid) + ".txt";
-        std::ifstream file(path);
-        if (!file) {
-            std::cerr << "Error: no se encontró " << path << "\n";
-            return false;
-        }
-        std::vector<std::string> lista;
-        std::string line;
-        int lineNum = 0;
-        while (std::getline(file, line)) {
-            ++lineNum;
-            if (trim(line).empty()) continue; // ignorar líneas vacías
-            std::string err;
-            if (!validarInstruccion(line, err)) {
-                std::cerr << "Error en " << path << " (linea " << lineNum << "): " << err
-                          << " | Texto: " << line << "\n";
-                return false;
-            }
-            lista.push_back(line);
-        }
-        instrucciones_.push_back(lista);
+        IdPrograma id;
+        if (!cargarProgramaArchivo(path, catalogo_, id)) return false;
+        programas_.push_back(id);
     }
     return true;
 }
 
 bool CargadorInstrucciones::cargarInstruccionesDesdeConsola(const std::vector<Proceso>& procesos) {
-    instrucciones_.clear();
-    std::cout << "\nIngrese instrucciones por proceso (una por línea). "
-                 "Escriba END para terminar cada proceso.\n\n";
+    catalogo_ = CatalogoProgramas();
+    programas_.clear();
+    const bool avisos = entradaInteractiva();   // sin terminal (pipe) no se muestran avisos
+    if (avisos)
+        std::cout << "\nIngrese instrucciones por proceso (una por línea). "
+                     "Escriba END para terminar cada proceso.\n\n";
     for (const auto& p : procesos) {
-        std::cout << "[PID " << p.pid << "] Ingrese instrucciones (END para terminar):\n";
+        if (avisos) std::cout << "[PID " << p.pid << "] Ingrese instrucciones (END para terminar):\n";
         std::vector<std::string> lista;
         std::string line;
         int lineNum = 0;
         while (true) {
-            std::cout << "  > ";
-            std::getline(std::cin, line);
+            if (avisos) std::cout << "  > ";
+            if (!leerLineaEntrada(line)) {
+                std::cerr << "  Error: la entrada terminó sin END (PID " << p.pid << ")\n";
+                return false;
+            }
             if (line == "END") break;
             if (trim(line).empty()) continue;
             ++lineNum;
@@ -163,13 +219,12 @@ bool CargadorInstrucciones::cargarInstruccionesDesdeConsola(const std::vector<Pr
             }
             lista.push_back(line);
         }
-        instrucciones_.push_back(lista);
-        std::cout << "\n";
+        bool nuevo = false;
+        const IdPrograma id = catalogo_.internar(lista, &nuevo);
+        if (nuevo) reportarAnalisis(std::cerr, catalogo_.analisis(id), "PID " + std::to_string(p.pid));
+        programas_.push_back(id);
+        if (avisos) std::cout << "\n";
     }
     return true;
 }
 
-const std::vector<std::vector<std::string>>&
-CargadorInstrucciones::getInstrucciones() const {
-    return instrucciones_;
-}
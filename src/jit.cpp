@@ -0,0 +1,205 @@
+
+/**
+ * @file jit.cpp
+ * @brief Generador de código x86-64 para los programas de los procesos.
+ *
+ * Disposición del código generado (System V: rdi = &EstadoNativo, rsi = entrada):
+ * - prólogo: carga AX/BX/CX en r8/r9/r10 y el presupuesto en rsi; salta a la entrada;
+ * - cuerpos de las instrucciones compiladas, en orden (un NOP no ocupa bytes); si la
+ *   siguiente no está compilada, salto a su salida;
+ * - una entrada por PC compilado: verifica y descuenta el tramo, salta al cuerpo;
+ * - una salida por PC (mov eax, pc) y el epílogo común que guarda registros, presupuesto
+ *   y PC en EstadoNativo.
+ * Todos los registros usados son volátiles en System V: no hace falta guardar ninguno.
+ */
+#include "jit.h"
+
+#if defined(__x86_64__) && defined(__linux__) && !SIM_SATURAR
+#define SIM_JIT_X86_64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstring>
+#endif
+
+// Estado que intercambian el código nativo y el simulador
+struct EstadoNativo {
+    Registro regs[3];       // AX, BX, CX
+    int64_t presupuesto;    // instrucciones que aún puede ejecutar
+    int64_t pc;
+};
+
+using FuncionNativa = void (*)(EstadoNativo*, const void* entrada);
+
+CodigoNativo::CodigoNativo(void* base, size_t tam, std::vector<int32_t> entradas)
+    : base_(base), tam_(tam), entradas_(std::move(entradas)) {}
+
+long long CodigoNativo::ejecutar(Proceso& p, long long presupuesto) const {
+    EstadoNativo e{{p.ax, p.bx, p.cx}, presupuesto, p.pc};
+    const char* base = static_cast<const char*>(base_);
+    reinterpret_cast<FuncionNativa>(base_)(&e, base + entradas_[p.pc]);
+    p.ax = e.regs[0];
+    p.bx = e.regs[1];
+    p.cx = e.regs[2];
+    p.pc = static_cast<int>(e.pc);
+    return presupuesto - e.presupuesto;
+}
+
+#ifdef SIM_JIT_X86_64
+
+CodigoNativo::~CodigoNativo() { munmap(base_, tam_); }
+
+bool jitDisponible() { return true; }
+
+// Instrucciones que el generador sabe traducir
+static bool compilable(OpCode op) {
+    switch (op) {
+        case OpCode::ADD: case OpCode::SUB: case OpCode::MUL: case OpCode::INC:
+        case OpCode::JMP: case OpCode::NOP: case OpCode::DESCONOCIDA:
+            return true;
+        default:
+            return false;
+    }
+}
+
+namespace {
+
+// Números de registro x86-64
+constexpr int RAX = 0, RSI = 6, RDI = 7;
+constexpr int kReg[3] = {8, 9, 10};   // AX, BX, CX → r8, r9, r10
+constexpr bool W = sizeof(Registro) == 8;   // operaciones de 64 bits (REX.W) o de 32
+
+enum class Destino { CUERPO, SALIDA, EPILOGO };
+
+class Emisor {
+public:
+    std::vector<uint8_t> c;
+
+    void byte(uint8_t b) { c.push_back(b); }
+    void imm32(int32_t v) {
+        uint32_t u = static_cast<uint32_t>(v);
+        for (int k = 0; k < 4; ++k) byte(static_cast<uint8_t>(u >> (8 * k)));
+    }
+    // Prefijo REX: w = operando de 64 bits; r/b = registros de los campos reg y r/m
+    void rex(bool w, int r, int b) {
+        uint8_t v = 0x40 | (w ? 8 : 0) | ((r & 8) ? 4 : 0) | ((b & 8) ? 1 : 0);
+        if (v != 0x40) byte(v);
+    }
+    void modrm(int mod, int reg, int rm) { byte(static_cast<uint8_t>(mod << 6 | (reg & 7) << 3 | (rm & 7))); }
+
+    // op dst, src (0x01 add, 0x29 sub)
+    void aluRR(uint8_t op, int dst, int src) { rex(W, src, dst); byte(op); modrm(3, src, dst); }
+    // grupo 0x81 /ext: op dst, imm32 (ext 0 add, 5 sub, 7 cmp)
+    void aluRI(int ext, int dst, int32_t v, bool w = W) { rex(w, 0, dst); byte(0x81); modrm(3, ext, dst); imm32(v); }
+    void imulRR(int dst, int src) { rex(W, dst, src); byte(0x0F); byte(0xAF); modrm(3, dst, src); }
+    void imulRI(int dst, int32_t v) { rex(W, dst, dst); byte(0x69); modrm(3, dst, dst); imm32(v); }
+    // mov reg, [rdi+d] (0x8B) / mov [rdi+d], reg (0x89)
+    void memRDI(uint8_t op, int reg, size_t d, bool w) { rex(w, reg, RDI); byte(op); modrm(1, reg, RDI); byte(static_cast<uint8_t>(d)); }
+
+    // Saltos rel32 a etiquetas que se resuelven al final
+    void jmp(Destino d, int i) { byte(0xE9); pendiente(d, i); }
+    void jb(Destino d, int i) { byte(0x0F); byte(0x82); pendiente(d, i); }
+
+    struct Arreglo { size_t pos; Destino d; int i; };
+    std::vector<Arreglo> arreglos;
+
+private:
+    void pendiente(Destino d, int i) { arreglos.push_back({c.size(), d, i}); imm32(0); }
+};
+
+} // namespace
+
+std::unique_ptr<CodigoNativo> compilarNativo(const Programa& prog) {
+    const std::vector<Instruccion>& cod = prog.codigo;
+    const int n = static_cast<int>(cod.size());
+
+    // tramo[i]: instrucciones desde i hasta el próximo JMP (inclusive) o la próxima no compilada
+    std::vector<int32_t> tramo(n + 1, 0);
+    bool alguna = false;
+    for (int i = n - 1; i >= 0; --i) {
+        if (!compilable(cod[i].op)) continue;
+        alguna = true;
+        tramo[i] = 1 + (cod[i].op == OpCode::JMP ? 0 : tramo[i + 1]);
+    }
+    if (!alguna) return nullptr;
+
+    Emisor e;
+    const size_t offRegs = offsetof(EstadoNativo, regs);
+    const size_t offPres = offsetof(EstadoNativo, presupuesto);
+    const size_t offPc = offsetof(EstadoNativo, pc);
+
+    // Prólogo: rax = entrada; cargar registros y presupuesto
+    e.byte(0x48); e.byte(0x89); e.modrm(3, RSI, RAX);            // mov rax, rsi
+    for (int r = 0; r < 3; ++r) e.memRDI(0x8B, kReg[r], offRegs + r * sizeof(Registro), W);
+    e.memRDI(0x8B, RSI, offPres, true);
+    e.byte(0xFF); e.modrm(3, 4, RAX);                            // jmp rax
+
+    // Verifica el tramo que empieza en t y salta a su cuerpo (o sale si t no está compilado)
+    auto saltarA = [&](int t) {
+        if (tramo[t] == 0) { e.jmp(Destino::SALIDA, t); return; }
+        e.aluRI(7, RSI, tramo[t], true);                         // cmp rsi, tramo
+        e.jb(Destino::SALIDA, t);
+        e.aluRI(5, RSI, tramo[t], true);                         // sub rsi, tramo
+        e.jmp(Destino::CUERPO, t);
+    };
+
+    std::vector<int32_t> cuerpo(n, -1), salida(n + 1, -1), entradas(n, -1);
+    for (int i = 0; i < n; ++i) {
+        const Instruccion& ins = cod[i];
+        if (!compilable(ins.op)) continue;
+        cuerpo[i] = static_cast<int32_t>(e.c.size());
+        const int dst = kReg[ins.dst];
+        const bool inm = ins.src == kInmediato;
+        const int src = inm ? 0 : kReg[ins.src];
+        switch (ins.op) {
+            case OpCode::ADD: inm ? e.aluRI(0, dst, ins.inm) : e.aluRR(0x01, dst, src); break;
+            case OpCode::SUB: inm ? e.aluRI(5, dst, ins.inm) : e.aluRR(0x29, dst, src); break;
+            case OpCode::MUL: inm ? e.imulRI(dst, ins.inm) : e.imulRR(dst, src); break;
+            case OpCode::INC: e.aluRI(0, dst, 1); break;
+            case OpCode::JMP: saltarA(ins.inm); continue;
+            default: break;                                      // NOP: sin código
+        }
+        if (i + 1 == n || !compilable(cod[i + 1].op)) e.jmp(Destino::SALIDA, i + 1);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (!compilable(cod[i].op)) continue;
+        entradas[i] = static_cast<int32_t>(e.c.size());
+        saltarA(i);
+    }
+    for (int t = 0; t <= n; ++t) {
+        salida[t] = static_cast<int32_t>(e.c.size());
+        e.byte(0xB8); e.imm32(t);                                // mov eax, t
+        e.jmp(Destino::EPILOGO, 0);
+    }
+    const int32_t epilogo = static_cast<int32_t>(e.c.size());
+    for (int r = 0; r < 3; ++r) e.memRDI(0x89, kReg[r], offRegs + r * sizeof(Registro), W);
+    e.memRDI(0x89, RSI, offPres, true);
+    e.memRDI(0x89, RAX, offPc, true);
+    e.byte(0xC3);                                                // ret
+
+    for (const Emisor::Arreglo& a : e.arreglos) {
+        const int32_t destino = a.d == Destino::CUERPO ? cuerpo[a.i]
+                              : a.d == Destino::SALIDA ? salida[a.i] : epilogo;
+        const int32_t rel = destino - static_cast<int32_t>(a.pos + 4);
+        std::memcpy(&e.c[a.pos], &rel, 4);
+    }
+
+    // W^X: se escribe con permiso de escritura y se ejecuta con lectura/ejecución
+    const size_t pagina = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t tam = (e.c.size() + pagina - 1) / pagina * pagina;
+    void* base = mmap(nullptr, tam, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return nullptr;
+    std::memcpy(base, e.c.data(), e.c.size());
+    if (mprotect(base, tam, PROT_READ | PROT_EXEC) != 0) { munmap(base, tam); return nullptr; }
+    return std::unique_ptr<CodigoNativo>(new CodigoNativo(base, tam, std::move(entradas)));
+}
+
+#else
+
+CodigoNativo::~CodigoNativo() {}
+
+bool jitDisponible() { return false; }
+
+std::unique_ptr<CodigoNativo> compilarNativo(const Programa&) { return nullptr; }
+
+#endif
@@ -13,12 +13,32 @@
  * - Ejecución de la simulación con planificación Round-Robin.
  * - Exportación opcional de la salida y errores a un archivo de log.
  * - Permite ejecutar múltiples simulaciones en una misma sesión.
+ * - Opciones de línea de comandos para configurar la memoria virtual:
+ *     --marcos=N --pagina=N --paginas=N --tlb=N --reemplazo=FIFO|LRU|CLOCK
+ *   y el costo del cambio de contexto: --cc-fijo=N --cc-frio=N --cc-vida=N
+ * - Selección del motor de ejecución (--motor, --hilos para el paralelo, --jit para
+ *   compilar a código nativo los programas más ejecutados), tope de
+ *   instrucciones (--limite), grabación/reproducción de trazas binarias (--grabar,
+ *   --reproducir) y el arnés diferencial referencia vs. decodificado (--diferencial=N).
+ * - Admisión en flujo (--flujo=ARCHIVO|-): los procesos se leen de a uno al llegar su
+ *   instante (campo Llegada) y sus programas de --instr=DIR; corre sin menú y termina.
+ *   --silencioso muestra solo el reporte final.
+ * - Bitácora de rebanadas (--bitacora): en lugar de la traza por instrucción se guarda un
+ *   resumen por rebanada; --detalle=A-B y/o --detalle-pid=N reconstruyen la traza
+ *   detallada solo de ese tramo re-ejecutándolo desde el estado registrado.
+ * - Consulta en vivo (--monitor=SOCKET): un hilo atiende un socket Unix con el estado de
+ *   la simulación en curso (ver monitor.h y el cliente bin/simctl).
+ * - Entrada por pipe: si stdin no es una terminal, los cargadores de consola no muestran
+ *   avisos y la entrada se lee en bloques grandes (ver entrada.h).
  *
  * Dependencias:
  * - cargador.h: Definición de CargadorProcesos para cargar procesos.
  * - instrucciones.h: Definición de CargadorInstrucciones para cargar instrucciones.
  * - planificador.h: Definición de PlanificadorRoundRobin para la simulación.
+ * - diferencial.h: Arnés de pruebas diferenciales entre motores.
+ * - bitacora.h: Resumen por rebanada y reconstrucción de trazas bajo demanda.
  * - logger.h: Definición de TeeBuf para duplicar la salida a archivo.
+ * - entrada.h: Lectura de líneas de consola compartida por el menú y los cargadores.
  *
  * @author
  * @date
@@ -29,35 +49,247 @@
 #include "cargador.h"
 #include "instrucciones.h"
 #include "planificador.h"
+#include "diferencial.h"
 #include "logger.h"  
+#include "entrada.h"
 
 static void sep(char ch='=', int n=60){ for(int i=0;i<n;++i) std::cout<<ch; std::cout<<"\n"; }
 
+// Opciones de línea de comandos
+struct Opciones {
+    ConfigMemoria memoria;
+    ConfigCambioContexto cambio;
+    Motor motor = Motor::REFERENCIA;
+    unsigned hilos = 0;          // motor paralelo: 0 = los núcleos disponibles
+    long long jit = -1;          // umbral del nivel JIT (-1 = desactivado)
+    long long limite = -1;
+    std::string grabar;          // archivo de traza binaria a grabar
+    std::string reproducir;      // archivo de traza binaria a verificar
+    int diferencial = 0;         // > 0: ejecutar el arnés diferencial y salir
+    ConfigDiferencial dif;
+    std::string flujo;           // archivo de procesos ("-" = stdin) para admisión en flujo
+    std::string instrDir = "instr";
+    bool silencioso = false;     // solo el reporte final
+    bool bitacora = false;       // resumen por rebanada en lugar de la traza completa
+    long long detalleDesde = 0;  // rebanadas a reconstruir (0 = ninguna; hasta -1 = al final)
+    long long detalleHasta = -1;
+    int detallePid = -1;
+    std::string monitor;         // socket Unix para consultar la simulación en vivo
+};
+
+static void uso() {
+    std::cerr << "Uso: simulador [--marcos=N] [--pagina=N] [--paginas=N] [--tlb=N]"
+                 " [--reemplazo=FIFO|LRU|CLOCK]\n"
+                 "                 [--cc-fijo=N] [--cc-frio=N] [--cc-vida=N]\n"
+                 "                 [--motor=referencia|decodificado|paralelo [--hilos=N]] [--jit[=UMBRAL]]\n"
+                 "                 [--limite=N]\n"
+                 "                 [--grabar=ARCHIVO] [--reproducir=ARCHIVO]\n"
+                 "                 [--diferencial=N [--semilla=S] [--procesos=N] [--largo=N]]\n"
+                 "                 [--flujo=ARCHIVO|- [--instr=DIR]] [--silencioso]\n"
+                 "                 [--bitacora] [--detalle=A[-B]] [--detalle-pid=N] [--monitor=SOCKET]\n";
+}
+
+// Lee un rango de rebanadas "A", "A-" o "A-B" (numeradas desde 1)
+static bool parseRango(const std::string& val, long long& desde, long long& hasta) {
+    size_t guion = val.find('-');
+    try {
+        size_t idx=0;
+        desde = std::stoll(val.substr(0, guion), &idx);
+        if (idx != (guion == std::string::npos ? val.size() : guion) || desde < 1) return false;
+        if (guion == std::string::npos) { hasta = desde; return true; }
+        if (guion + 1 == val.size()) { hasta = -1; return true; }
+        hasta = std::stoll(val.substr(guion + 1), &idx);
+        return idx == val.size() - guion - 1 && hasta >= desde;
+    } catch (...) { return false; }
+}
+
+// Lee "--clave=valor" entero positivo (o >= 0 si admiteCero)
+template <typename T>
+static bool parseOpcionEntera(const std::string& val, T& out, bool admiteCero=false) {
+    try {
+        size_t idx=0; long long v = std::stoll(val, &idx);
+        if (idx != val.size() || v < (admiteCero ? 0 : 1)) return false;
+        out = static_cast<T>(v); return true;
+    } catch (...) { return false; }
+}
+
+static bool parseOpciones(int argc, char* argv[], Opciones& o) {
+    ConfigMemoria& mem = o.memoria;
+    ConfigCambioContexto& cc = o.cambio;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) continue;   // argumentos posicionales: se ignoran
+        size_t eq = arg.find('=');
+        std::string clave = arg.substr(2, eq == std::string::npos ? std::string::npos : eq - 2);
+        std::string val = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        bool ok = true;
+        if (clave == "marcos")        ok = parseOpcionEntera(val, mem.marcos);
+        else if (clave == "pagina")   ok = parseOpcionEntera(val, mem.tamPagina);
+        else if (clave == "paginas")  ok = parseOpcionEntera(val, mem.paginasPorProceso);
+        else if (clave == "tlb")      ok = parseOpcionEntera(val, mem.entradasTLB, true);
+        else if (clave == "reemplazo") ok = parsePoliticaReemplazo(val, mem.politica);
+        else if (clave == "cc-fijo")  ok = parseOpcionEntera(val, cc.costoFijo, true);
+        else if (clave == "cc-frio")  ok = parseOpcionEntera(val, cc.penalizacionFria, true);
+        else if (clave == "cc-vida")  ok = parseOpcionEntera(val, cc.vidaMedia);
+        else if (clave == "motor") {
+            if (val == "referencia") o.motor = Motor::REFERENCIA;
+            else if (val == "decodificado") o.motor = Motor::DECODIFICADO;
+            else if (val == "paralelo") o.motor = Motor::PARALELO;
+            else ok = false;
+        }
+        else if (clave == "limite")   ok = parseOpcionEntera(val, o.limite);
+        else if (clave == "hilos")    ok = parseOpcionEntera(val, o.hilos);
+        else if (clave == "jit")      { o.jit = 1000; ok = val.empty() || parseOpcionEntera(val, o.jit, true); }
+        else if (clave == "grabar")   { o.grabar = val; ok = !val.empty(); }
+        else if (clave == "reproducir") { o.reproducir = val; ok = !val.empty(); }
+        else if (clave == "diferencial") ok = parseOpcionEntera(val, o.diferencial);
+        else if (clave == "semilla")  ok = parseOpcionEntera(val, o.dif.semilla, true);
+        else if (clave == "procesos") ok = parseOpcionEntera(val, o.dif.procesos);
+        else if (clave == "largo")    ok = parseOpcionEntera(val, o.dif.largo);
+        else if (clave == "flujo")    { o.flujo = val; ok = !val.empty(); }
+        else if (clave == "instr")    { o.instrDir = val; ok = !val.empty(); }
+        else if (clave == "silencioso") o.silencioso = true;
+        else if (clave == "bitacora") o.bitacora = true;
+        else if (clave == "detalle")  { ok = parseRango(val, o.detalleDesde, o.detalleHasta); o.bitacora = true; }
+        else if (clave == "detalle-pid") { ok = parseOpcionEntera(val, o.detallePid, true); o.bitacora = true; }
+        else if (clave == "monitor")  { o.monitor = val; ok = !val.empty(); }
+        else { std::cerr << "Opcion desconocida: " << arg << "\n"; uso(); return false; }
+        if (!ok) { std::cerr << "Valor invalido en: " << arg << "\n"; uso(); return false; }
+    }
+    if (o.jit >= 0 && o.motor == Motor::REFERENCIA && o.diferencial == 0)
+        std::cerr << "Aviso: --jit requiere --motor=decodificado o paralelo; se ignora.\n";
+    else if (o.jit >= 0 && !jitDisponible())
+        std::cerr << "Aviso: no hay JIT en esta plataforma o con registros saturados; se interpreta.\n";
+    return true;
+}
+
+// Conecta el grabador o verificador de trazas pedido por línea de comandos
+static void prepararTraza(const Opciones& opc, PlanificadorRoundRobin& rr,
+                          GrabadorTraza& grabador, VerificadorTraza& verificador) {
+    if (!opc.grabar.empty()) {
+        if (grabador.abrir(opc.grabar)) rr.configurarObservador(&grabador);
+        else std::cerr << "No se pudo crear " << opc.grabar << ". Se continua sin grabar.\n";
+    } else if (!opc.reproducir.empty()) {
+        if (verificador.abrir(opc.reproducir)) rr.configurarObservador(&verificador);
+        else if (!verificador.motivo().empty())
+            std::cerr << "Traza incompatible " << opc.reproducir << ": " << verificador.motivo() << "\n";
+        else std::cerr << "Traza invalida o inexistente: " << opc.reproducir << "\n";
+    }
+}
+
+static void cerrarTraza(const Opciones& opc, GrabadorTraza& grabador,
+                        VerificadorTraza& verificador) {
+    if (!opc.grabar.empty() && grabador.eventos() > 0) {
+        grabador.cerrar();
+        std::cout << "\n[Traza grabada en " << opc.grabar << ": "
+                  << grabador.eventos() << " eventos]\n";
+    } else if (!opc.reproducir.empty()) {
+        verificador.terminar();
+        if (!verificador.divergencia()) {
+            std::cout << "\n[Reproduccion OK: " << verificador.indice()
+                      << " eventos identicos a " << opc.reproducir << "]\n";
+        } else {
+            std::cout << "\n[Reproduccion DIVERGE en el evento #" << verificador.indice() << "]\n";
+            if (verificador.faltanteEsperado()) std::cout << "  Grabado:  (sin mas eventos)\n";
+            else std::cout << "  Grabado:  " << verificador.esperado() << "\n";
+            if (verificador.faltanteObtenido()) std::cout << "  Obtenido: (sin mas eventos)\n";
+            else std::cout << "  Obtenido: " << verificador.obtenido() << "\n";
+        }
+    }
+}
+
+// Resumen de la bitácora y, si se pidió, la traza reconstruida del tramo seleccionado
+static void mostrarBitacora(const Opciones& opc, const BitacoraRebanadas& bitacora) {
+    if (!opc.bitacora) return;
+    bitacora.imprimirResumen(std::cout);
+    if (opc.detalleDesde == 0 && opc.detallePid < 0) return;
+    std::cout << "\nTRAZA DETALLADA RECONSTRUIDA\n";
+    sep('=');
+    long long n = bitacora.renderizar(std::cout, opc.detalleDesde > 0 ? opc.detalleDesde : 1,
+                                      opc.detalleDesde > 0 ? opc.detalleHasta : -1, opc.detallePid);
+    if (n == 0) std::cout << "  (ninguna rebanada en el tramo pedido)\n";
+}
+
+// Modo no interactivo: admisión en flujo desde archivo o stdin
+static int simularFlujo(const Opciones& opc, MonitorSimulacion* monitor) {
+    CargadorProcesosFlujo fuente;
+    if (!fuente.abrir(opc.flujo, opc.instrDir)) return 1;
+
+    PlanificadorRoundRobin rr;
+    rr.configurarMemoria(opc.memoria);
+    rr.configurarCambioContexto(opc.cambio);
+    rr.configurarMotor(opc.motor);
+    rr.configurarHilos(opc.hilos);
+    rr.configurarJit(opc.jit);
+    rr.configurarLimite(opc.limite);
+    rr.configurarSalida(opc.silencioso || opc.bitacora ? Salida::RESUMEN : Salida::COMPLETA);
+    rr.configurarMonitor(monitor);
+    BitacoraRebanadas bitacora;
+    if (opc.bitacora) rr.configurarBitacora(&bitacora);
+
+    GrabadorTraza grabador;
+    VerificadorTraza verificador;
+    prepararTraza(opc, rr, grabador, verificador);
+    rr.simular(fuente);
+    cerrarTraza(opc, grabador, verificador);
+    mostrarBitacora(opc, bitacora);
+
+    std::cout << "\n[Procesos admitidos: " << fuente.leidos() << "]\n";
+    return fuente.error() ? 1 : 0;
+}
+
 static int menu() {
-    sep('='); std::cout << "SIMULADOR DE PROCESOS (Round-Robin)\n"; sep('=');
-    std::cout << "Seleccione modo de entrada:\n"
-              << "  1) Desde ARCHIVO (procesos.txt + instr/<PID>.txt)\n"
-              << "  2) Desde CONSOLA\n"
-              << "  3) Salir\n> ";
-    std::string op; std::getline(std::cin, op);
+    if (entradaInteractiva()) {   // sin terminal (pipe) no se muestran menú ni avisos
+        sep('='); std::cout << "SIMULADOR DE PROCESOS (Round-Robin)\n"; sep('=');
+        std::cout << "Seleccione modo de entrada:\n"
+                  << "  1) Desde ARCHIVO (procesos.txt + instr/<PID>.txt)\n"
+                  << "  2) Desde CONSOLA\n"
+                  << "  3) Salir\n> ";
+    }
+    std::string op; leerLineaEntrada(op);
     if (op=="1") return 1; if (op=="2") return 2; return 3;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    Opciones opc;
+    if (!parseOpciones(argc, argv, opc)) return 1;
+    prepararEntrada();
+
+    if (opc.diferencial > 0) {
+        opc.dif.cargas = opc.diferencial;
+        opc.dif.memoria = opc.memoria;
+        opc.dif.cambio = opc.cambio;
+        if (opc.limite > 0) opc.dif.limite = opc.limite;
+        if (opc.motor != Motor::REFERENCIA) opc.dif.motor = opc.motor;
+        opc.dif.hilos = opc.hilos;
+        opc.dif.jit = opc.jit;
+        return ejecutarDiferencial(opc.dif, std::cout) ? 0 : 1;
+    }
+
+    MonitorSimulacion monitor;
+    MonitorSimulacion* mon = nullptr;
+    if (!opc.monitor.empty()) {
+        if (monitor.iniciar(opc.monitor)) mon = &monitor;
+        else std::cerr << "Se continua sin monitor.\n";
+    }
+    if (!opc.flujo.empty()) return simularFlujo(opc, mon);
+
+    const bool avisos = entradaInteractiva();   // sin terminal (pipe) no se muestran avisos
+
     while (true) {
         int op = menu();
         if (op == 3) { std::cout << "Saliendo...\n"; return 0; }
 
         // --- ACTIVAR LOG ---
         bool usarLog = false;
-        std::cout << "¿Exportar el seguimiento a .log? (s/n): ";
-        std::string r; std::getline(std::cin, r);
+        if (avisos) std::cout << "¿Exportar el seguimiento a .log? (s/n): ";
+        std::string r; leerLineaEntrada(r);
         if (!r.empty() && (r=="s" || r=="S")) usarLog = true;
 
         std::string logName = "simulacion.log";
         if (usarLog) {
-            std::cout << "Nombre del archivo .log [simulacion.log]: ";
-            std::string tmp; std::getline(std::cin, tmp);
+            if (avisos) std::cout << "Nombre del archivo .log [simulacion.log]: ";
+            std::string tmp; leerLineaEntrada(tmp);
             if (!tmp.empty()) logName = tmp;
         }
 
@@ -88,8 +320,8 @@ int main() {
 
         if (op == 1) {
             std::string file;
-            std::cout << "Archivo de procesos [default: procesos.txt]: ";
-            std::getline(std::cin, file);
+            if (avisos) std::cout << "Archivo de procesos [default: procesos.txt]: ";
+            leerLineaEntrada(file);
             if (file.empty()) file = "procesos.txt";
             if (!carg.cargarProcesos(file)) {
                 // Restaurar buffers si hubo log antes de continuar el while
@@ -137,7 +369,26 @@ int main() {
 
         std::cout << "\n→ Empezando simulacion...\n\n";
         PlanificadorRoundRobin rr;
-        rr.schedule(procesos, ci.getInstrucciones());
+        rr.configurarMemoria(opc.memoria);
+        rr.configurarCambioContexto(opc.cambio);
+        rr.configurarMotor(opc.motor);
+        rr.configurarHilos(opc.hilos);
+        rr.configurarJit(opc.jit);
+        rr.configurarLimite(opc.limite);
+        rr.configurarMonitor(mon);
+        BitacoraRebanadas bitacora;
+        if (opc.bitacora) {
+            rr.configurarSalida(Salida::RESUMEN);
+            rr.configurarBitacora(&bitacora);
+        }
+
+        GrabadorTraza grabador;
+        VerificadorTraza verificador;
+        prepararTraza(opc, rr, grabador, verificador);
+        rr.schedule(procesos, ci.getCatalogo(), ci.getProgramas());
+        mostrarBitacora(opc, bitacora);
+
+        cerrarTraza(opc, grabador, verificador);
 
         if (usarLog) {
             std::cout << "\n[Log guardado en " << logName << "]\n";
@@ -147,8 +398,8 @@ int main() {
             log.close();
         }
 
-        std::cout << "\n¿Desea ejecutar otra simulacion? (s/n): ";
-        std::string again; std::getline(std::cin, again);
+        if (avisos) std::cout << "\n¿Desea ejecutar otra simulacion? (s/n): ";
+        std::string again; leerLineaEntrada(again);
         if (again!="s" && again!="S") break;
     }
     return 0;
@@ -0,0 +1,216 @@
+
+/**
+ * @file memoria.cpp
+ * @brief Implementación de MemoriaVirtual: paginación bajo demanda, TLB y reemplazo de páginas.
+ *
+ * Flujo de un acceso (LOAD/STORE):
+ * - Se valida la dirección contra el tamaño del espacio virtual del proceso.
+ * - Se busca la página en la TLB; si falla, se consulta la tabla de páginas.
+ * - Si la página no está residente (fallo de página) se obtiene un marco libre o se
+ *   expulsa una víctima (FIFO, LRU o Clock), guardando en swap las páginas sucias.
+ * - Se registra el acceso (LRU mueve el marco al final de la lista; Clock marca el bit).
+ *
+ * La lista FIFO/LRU es doblemente enlazada sobre índices de marco (prev_/next_), de modo
+ * que insertar, mover al final y expulsar la cabeza son operaciones O(1).
+ */
+#include "memoria.h"
+#include <algorithm>
+#include <cctype>
+
+bool parsePoliticaReemplazo(const std::string& s, PoliticaReemplazo& out) {
+    std::string u = s;
+    std::transform(u.begin(), u.end(), u.begin(),
+                   [](unsigned char c){ return std::toupper(c); });
+    if (u == "FIFO")  { out = PoliticaReemplazo::FIFO;  return true; }
+    if (u == "LRU")   { out = PoliticaReemplazo::LRU;   return true; }
+    if (u == "CLOCK") { out = PoliticaReemplazo::CLOCK; return true; }
+    return false;
+}
+
+const char* nombrePolitica(PoliticaReemplazo p) {
+    switch (p) {
+        case PoliticaReemplazo::FIFO:  return "FIFO";
+        case PoliticaReemplazo::LRU:   return "LRU";
+        case PoliticaReemplazo::CLOCK: return "Clock";
+    }
+    return "?";
+}
+
+MemoriaVirtual::MemoriaVirtual(const ConfigMemoria& cfg, int nProcesos)
+    : cfg_(cfg),
+      fallosPorProceso_(nProcesos, 0),
+      tablaPaginas_(static_cast<size_t>(nProcesos) * cfg.paginasPorProceso, -1),
+      dueno_(cfg.marcos, -1),
+      vpn_(cfg.marcos, -1),
+      sucio_(cfg.marcos, 0),
+      ref_(cfg.marcos, 0),
+      prev_(cfg.marcos, -1),
+      next_(cfg.marcos, -1),
+      datos_(static_cast<size_t>(cfg.marcos) * cfg.tamPagina, 0),
+      tlbVpn_(cfg.entradasTLB, -1),
+      tlbMarco_(cfg.entradasTLB, -1) {
+    // Pila de libres: el marco 0 sale primero
+    for (int m = cfg.marcos - 1; m >= 0; --m) libres_.push_back(m);
+}
+
+void MemoriaVirtual::asegurarProcesos(int nProcesos) {
+    if (nProcesos <= static_cast<int>(fallosPorProceso_.size())) return;
+    fallosPorProceso_.resize(nProcesos, 0);
+    tablaPaginas_.resize(static_cast<size_t>(nProcesos) * cfg_.paginasPorProceso, -1);
+}
+
+void MemoriaVirtual::enlazarAlFinal(int m) {
+    prev_[m] = cola_;
+    next_[m] = -1;
+    if (cola_ >= 0) next_[cola_] = m; else cabeza_ = m;
+    cola_ = m;
+}
+
+void MemoriaVirtual::desenlazar(int m) {
+    if (prev_[m] >= 0) next_[prev_[m]] = next_[m]; else cabeza_ = next_[m];
+    if (next_[m] >= 0) prev_[next_[m]] = prev_[m]; else cola_ = prev_[m];
+    prev_[m] = next_[m] = -1;
+}
+
+void MemoriaVirtual::tocar(int m) {
+    if (cfg_.politica == PoliticaReemplazo::LRU) {
+        if (cola_ != m) { desenlazar(m); enlazarAlFinal(m); }
+    } else if (cfg_.politica == PoliticaReemplazo::CLOCK) {
+        ref_[m] = 1;
+    }
+}
+
+void MemoriaVirtual::expulsar(int m) {
+    const int o = dueno_[m];
+    const int v = vpn_[m];
+    const long long clave = static_cast<long long>(o) * cfg_.paginasPorProceso + v;
+    if (sucio_[m]) {
+        auto first = datos_.begin() + static_cast<long long>(m) * cfg_.tamPagina;
+        swap_[clave].assign(first, first + cfg_.tamPagina);
+        stats_.escriturasSwap++;
+    }
+    tablaPaginas_[clave] = -1;
+    if (procTLB_ == o) {
+        for (int i = 0; i < cfg_.entradasTLB; ++i)
+            if (tlbMarco_[i] == m) tlbVpn_[i] = tlbMarco_[i] = -1;
+    }
+    desenlazar(m);
+    dueno_[m] = vpn_[m] = -1;
+    sucio_[m] = ref_[m] = 0;
+    stats_.reemplazos++;
+}
+
+int MemoriaVirtual::obtenerMarco() {
+    if (!libres_.empty()) {
+        int m = libres_.back();
+        libres_.pop_back();
+        return m;
+    }
+    int victima;
+    if (cfg_.politica == PoliticaReemplazo::CLOCK) {
+        // Segunda oportunidad: limpiar bits de referencia hasta hallar uno en 0
+        while (ref_[manecilla_]) {
+            ref_[manecilla_] = 0;
+            manecilla_ = (manecilla_ + 1) % cfg_.marcos;
+        }
+        victima = manecilla_;
+        manecilla_ = (manecilla_ + 1) % cfg_.marcos;
+    } else {
+        victima = cabeza_;   // FIFO: el más antiguo; LRU: el menos usado
+    }
+    expulsar(victima);
+    return victima;
+}
+
+ResultadoAcceso MemoriaVirtual::traducir(int proc, long long dir, bool escritura, int& offset) {
+    ResultadoAcceso r;
+    if (dir < 0 || dir >= static_cast<long long>(cfg_.paginasPorProceso) * cfg_.tamPagina)
+        return r;
+    r.valido = true;
+    r.pagina = static_cast<int>(dir / cfg_.tamPagina);
+    offset = static_cast<int>(dir % cfg_.tamPagina);
+    stats_.accesos++;
+    if (procTLB_ != proc) cargarTLB(proc);   // primer acceso sin cambio previo: no cuenta
+
+    for (int i = 0; i < cfg_.entradasTLB; ++i) {
+        if (tlbVpn_[i] == r.pagina) { r.marco = tlbMarco_[i]; r.aciertoTLB = true; break; }
+    }
+
+    if (r.aciertoTLB) {
+        stats_.aciertosTLB++;
+    } else {
+        stats_.fallosTLB++;
+        const long long clave = static_cast<long long>(proc) * cfg_.paginasPorProceso + r.pagina;
+        r.marco = tablaPaginas_[clave];
+        if (r.marco < 0) {
+            // Fallo de página: traer desde swap (o página en ceros)
+            r.falloPagina = true;
+            stats_.fallosPagina++;
+            fallosPorProceso_[proc]++;
+            r.marco = obtenerMarco();
+            auto dst = datos_.begin() + static_cast<long long>(r.marco) * cfg_.tamPagina;
+            auto it = swap_.find(clave);
+            if (it != swap_.end()) std::copy(it->second.begin(), it->second.end(), dst);
+            else std::fill(dst, dst + cfg_.tamPagina, 0);
+            dueno_[r.marco] = proc;
+            vpn_[r.marco] = r.pagina;
+            tablaPaginas_[clave] = r.marco;
+            enlazarAlFinal(r.marco);
+        }
+        if (cfg_.entradasTLB > 0) {
+            tlbVpn_[tlbSiguiente_] = r.pagina;
+            tlbMarco_[tlbSiguiente_] = r.marco;
+            tlbSiguiente_ = (tlbSiguiente_ + 1) % cfg_.entradasTLB;
+        }
+    }
+
+    tocar(r.marco);
+    if (escritura) sucio_[r.marco] = 1;
+    return r;
+}
+
+ResultadoAcceso MemoriaVirtual::leer(int proc, long long dir, Registro& valor) {
+    int off = 0;
+    ResultadoAcceso r = traducir(proc, dir, false, off);
+    if (r.valido) valor = datos_[static_cast<long long>(r.marco) * cfg_.tamPagina + off];
+    return r;
+}
+
+ResultadoAcceso MemoriaVirtual::escribir(int proc, long long dir, Registro valor) {
+    int off = 0;
+    ResultadoAcceso r = traducir(proc, dir, true, off);
+    if (r.valido) datos_[static_cast<long long>(r.marco) * cfg_.tamPagina + off] = valor;
+    return r;
+}
+
+void MemoriaVirtual::cargarTLB(int proc) {
+    std::fill(tlbVpn_.begin(), tlbVpn_.end(), -1);
+    std::fill(tlbMarco_.begin(), tlbMarco_.end(), -1);
+    tlbSiguiente_ = 0;
+    procTLB_ = proc;
+}
+
+void MemoriaVirtual::cambioContexto(int proc) {
+    cargarTLB(proc);
+    stats_.vaciadosTLB++;
+}
+
+void MemoriaVirtual::liberarProceso(int proc) {
+    const long long base = static_cast<long long>(proc) * cfg_.paginasPorProceso;
+    for (int v = 0; v < cfg_.paginasPorProceso; ++v) {
+        int m = tablaPaginas_[base + v];
+        if (m >= 0) {
+            desenlazar(m);
+            dueno_[m] = vpn_[m] = -1;
+            sucio_[m] = ref_[m] = 0;
+            libres_.push_back(m);
+            tablaPaginas_[base + v] = -1;
+        }
+        if (!swap_.empty()) swap_.erase(base + v);
+    }
+    if (procTLB_ == proc) {
+        std::fill(tlbVpn_.begin(), tlbVpn_.end(), -1);
+        std::fill(tlbMarco_.begin(), tlbMarco_.end(), -1);
+        procTLB_ = -1;
+    }
+}
@@ -0,0 +1,153 @@
+
+/**
+ * @file monitor.cpp
+ * @brief Implementación del servidor de consulta en vivo (socket Unix + triple buffer).
+ */
+#include "monitor.h"
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__unix__)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+MonitorSimulacion::~MonitorSimulacion() { detener(); }
+
+// Las instrucciones por segundo de la primera publicación se miden desde aquí y no desde el
+// final de la corrida anterior (tiempo de menú incluido)
+void MonitorSimulacion::reiniciar() {
+    rebanadas_ = 0;
+    ultima_ = std::chrono::steady_clock::now();
+    instrAnteriores_ = 0;
+}
+
+bool MonitorSimulacion::toca() {
+    if (++rebanadas_ & 255u) return false;
+    const auto ahora = std::chrono::steady_clock::now();
+    return ahora - ultima_ >= std::chrono::milliseconds(100);
+}
+
+void MonitorSimulacion::publicar(InstantaneaSimulacion s) {
+    const auto ahora = std::chrono::steady_clock::now();
+    if (ultima_.time_since_epoch().count() != 0) {
+        const double seg = std::chrono::duration<double>(ahora - ultima_).count();
+        if (seg > 0) s.instrPorSegundo = (s.instrucciones - instrAnteriores_) / seg;
+    }
+    ultima_ = ahora;
+    instrAnteriores_ = s.instrucciones;
+    buffers_[escritura_] = s;
+    escritura_ = medio_.exchange(escritura_ | kNuevo, std::memory_order_acq_rel) & ~kNuevo;
+}
+
+void MonitorSimulacion::leer(InstantaneaSimulacion& s) {
+    if (medio_.load(std::memory_order_acquire) & kNuevo)
+        lectura_ = medio_.exchange(lectura_, std::memory_order_acq_rel) & ~kNuevo;
+    s = buffers_[lectura_];
+}
+
+#if defined(__unix__)
+
+// Respuesta en texto: una clave por línea y luego los procesos con más CPU
+static std::string formatear(const InstantaneaSimulacion& s) {
+    std::ostringstream os;
+    os << "estado=" << (s.terminada ? "terminada" : "ejecutando") << "\n"
+       << "reloj=" << s.reloj << "\n"
+       << "listos=" << s.listos << "\n"
+       << "bloqueados=" << s.bloqueados << "\n"
+       << "admitidos=" << s.admitidos << "\n"
+       << "completados=" << s.completados << "\n"
+       << "instrucciones=" << s.instrucciones << "\n"
+       << std::fixed << std::setprecision(0)
+       << "instrucciones_por_segundo=" << s.instrPorSegundo << "\n"
+       << std::setprecision(1);
+    for (int k = 0; k < s.nTop; ++k) {
+        const double parte = s.reloj > 0 ? 100.0 * s.top[k].cpu / s.reloj : 0.0;
+        os << "top" << k + 1 << "=PID " << s.top[k].pid << " cpu=" << s.top[k].cpu
+           << " (" << parte << "%)\n";
+    }
+    return os.str();
+}
+
+// Un socket que quedó de una corrida terminada por señal rechaza la conexión: se borra para
+// poder volver a crearlo. Si alguien responde, la ruta está en uso y no se toca.
+static void borrarSocketAbandonado(const sockaddr_un& dir) {
+    struct stat info;
+    if (lstat(dir.sun_path, &info) != 0 || !S_ISSOCK(info.st_mode)) return;   // nunca otro archivo
+    const int prueba = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (prueba < 0) return;
+    if (connect(prueba, reinterpret_cast<const sockaddr*>(&dir), sizeof(dir)) != 0
+        && errno == ECONNREFUSED) {
+        unlink(dir.sun_path);
+    }
+    close(prueba);
+}
+
+bool MonitorSimulacion::iniciar(const std::string& ruta) {
+    sockaddr_un dir{};
+    if (ruta.empty() || ruta.size() >= sizeof(dir.sun_path)) {
+        std::cerr << "Monitor: ruta de socket invalida: " << ruta << "\n";
+        return false;
+    }
+    fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd_ < 0) { std::cerr << "Monitor: no se pudo crear el socket\n"; return false; }
+    dir.sun_family = AF_UNIX;
+    std::strcpy(dir.sun_path, ruta.c_str());
+    borrarSocketAbandonado(dir);
+    if (bind(fd_, reinterpret_cast<sockaddr*>(&dir), sizeof(dir)) != 0 || listen(fd_, 8) != 0) {
+        std::cerr << "Monitor: no se pudo escuchar en " << ruta << " (" << std::strerror(errno)
+                  << ")\n";
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    ruta_ = ruta;
+    salir_ = false;
+    hilo_ = std::thread([this] { servir(); });
+    return true;
+}
+
+void MonitorSimulacion::servir() {
+    while (!salir_) {
+        pollfd p{fd_, POLLIN, 0};
+        if (poll(&p, 1, 200) <= 0) continue;     // despierta seguido para ver salir_
+        const int c = accept(fd_, nullptr, nullptr);
+        if (c < 0) continue;
+        InstantaneaSimulacion s;
+        leer(s);
+        const std::string r = formatear(s);
+        for (size_t enviado = 0; enviado < r.size();) {
+            const ssize_t k = send(c, r.data() + enviado, r.size() - enviado, MSG_NOSIGNAL);
+            if (k <= 0) break;                   // el cliente se fue
+            enviado += static_cast<size_t>(k);
+        }
+        close(c);
+    }
+}
+
+void MonitorSimulacion::detener() {
+    if (fd_ < 0) return;
+    salir_ = true;
+    if (hilo_.joinable()) hilo_.join();
+    close(fd_);
+    unlink(ruta_.c_str());
+    fd_ = -1;
+}
+
+#else
+
+bool MonitorSimulacion::iniciar(const std::string&) {
+    std::cerr << "Monitor: esta plataforma no tiene sockets Unix\n";
+    return false;
+}
+
+void MonitorSimulacion::servir() {}
+void MonitorSimulacion::detener() {}
+
+#endif
@@ -0,0 +1,332 @@
+
+/**
+ * @file motor.cpp
+ * @brief Implementación de los motores de ejecución de rebanadas (referencia y decodificado).
+ *
+ * El motor de referencia es el intérprete de texto original del planificador: analiza cada
+ * línea en cada paso e imprime la traza detallada. El motor decodificado reproduce la misma
+ * semántica sobre instrucciones ya decodificadas:
+ * - opcode desconocido → NOP;
+ * - operando inválido → el proceso cede la CPU sin consumir la instrucción;
+ * - JMP fuera de rango o violación de segmento → el PC salta al final (el proceso termina);
+ * - IO/SLEEP consumen 1 tick y bloquean al proceso.
+ *
+ * La aritmética de registros pasa por el Alu de la compilación (registro.h): ancho de
+ * 32 o 64 bits, envolvente o saturada. El motor decodificado es una plantilla sobre el
+ * Alu, de modo que el ancho y la semántica quedan resueltos en tiempo de compilación, pero
+ * se instancia una sola vez: Proceso, el motor de referencia, las trazas y el JIT usan
+ * Registro/Alu directamente, así que la configuración es una por binario.
+ */
+#include "motor.h"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <type_traits>
+
+static std::string trim(const std::string& s) {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    size_t b = s.find_last_not_of(" \t\r\n");
+    if (a == std::string::npos) return "";
+    return s.substr(a, b - a + 1);
+}
+static std::string upper(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c){ return std::toupper(c); });
+    return s;
+}
+
+static Registro& regRef(Proceso& p, const std::string& r) {
+    if (r == "AX") return p.ax;
+    if (r == "BX") return p.bx;
+    return p.cx; // CX por defecto
+}
+static bool isReg(const std::string& r) {
+    return r=="AX" || r=="BX" || r=="CX";
+}
+static bool parseIntSafe(const std::string& s, int& out) {
+    try {
+        size_t idx=0; int val = std::stoi(s, &idx);
+        if (idx != s.size()) return false;
+        out = val; return true;
+    } catch (...) { return false; }
+}
+
+// LOAD/STORE contra la memoria virtual, o contra los accesos grabados al re-ejecutar
+static ResultadoAcceso acceder(EstadoEjecucion& st, int idx, bool escritura, long long dir,
+                               Registro& valor) {
+    if (st.reproducirAccesos) {
+        const AccesoMemoria& a = *st.reproducirAccesos++;
+        if (!escritura) valor = a.valor;
+        return a.resultado;
+    }
+    ResultadoAcceso r = escritura ? st.memoria->escribir(idx, dir, valor)
+                                  : st.memoria->leer(idx, dir, valor);
+    if (st.registroAccesos) st.registroAccesos->push_back({r, valor});
+    return r;
+}
+
+static void emitirEvento(const EstadoEjecucion& st, const Proceso& p, int pcAntes) {
+    st.observador->instruccion({st.reloj, p.pid, pcAntes, p.pc, p.ax, p.bx, p.cx});
+}
+
+ResultadoRebanada ejecutarRebanadaReferencia(Proceso& p, int idx,
+                                             const std::vector<std::string>& prog,
+                                             EstadoEjecucion& st) {
+    std::ostream& out = *st.out;
+    std::ostream& err = *st.err;
+    ResultadoRebanada res;
+    auto emitir = [&](int pcAntes) {
+        st.instrucciones++;
+        if (st.observador) emitirEvento(st, p, pcAntes);
+    };
+
+    int q_rest = p.quantum;
+
+    while (q_rest > 0 && p.pc < static_cast<int>(prog.size())) {
+        if (st.limite >= 0 && st.instrucciones >= st.limite) { res.limite = true; break; }
+        int instrIndex = p.pc;               // PC antes de ejecutar
+        std::string raw = trim(prog[p.pc]);
+        std::string s = upper(raw);
+
+        // Parse op y operandos
+        std::string op, rest, a1, a2;
+        {
+            std::istringstream iss(s);
+            iss >> op;
+            std::getline(iss, rest);
+            rest = trim(rest);
+            size_t cpos = rest.find(',');
+            if (cpos != std::string::npos) {
+                a1 = trim(rest.substr(0,cpos));
+                a2 = trim(rest.substr(cpos+1));
+            } else {
+                a1 = trim(rest);
+            }
+        }
+
+        if (op=="ADD" || op=="SUB" || op=="MUL") {
+            if (!isReg(a1)) { err << "  ! Destino invalido en: " << raw << "\n"; break; }
+            Registro valSrc=0; bool srcIsImm=false;
+            if (isReg(a2)) { valSrc = regRef(p,a2); }
+            else {
+                int inm=0;
+                if (!parseIntSafe(a2, inm)) { err << "  ! Operando invalido en: " << raw << "\n"; break; }
+                valSrc = inm;
+                srcIsImm = true;
+            }
+            Registro before = regRef(p,a1);
+            if (op=="ADD") regRef(p,a1) = Alu::sumar(before, valSrc);
+            else if (op=="SUB") regRef(p,a1) = Alu::restar(before, valSrc);
+            else regRef(p,a1) = Alu::multiplicar(before, valSrc);
+
+            Registro after = regRef(p,a1);
+            p.pc++;        // avanzamos a la siguiente instrucción
+            q_rest--;      // consumimos quantum
+            st.reloj++;
+
+            out << "  - Instr[" << instrIndex << "] " << raw << "  | "
+                << a1 << ": " << before
+                << (op=="ADD"? " + " : (op=="SUB"? " - " : " * "))
+                << (srcIsImm? std::to_string(valSrc) : a2+"("+std::to_string(valSrc)+")")
+                << " = " << after
+                << "  | Quantum restante: " << q_rest << "\n";
+        }
+        else if (op=="INC") {
+            if (!isReg(a1)) { err << "  ! Registro invalido en: " << raw << "\n"; break; }
+            Registro before = regRef(p,a1);
+            regRef(p,a1) = Alu::sumar(before, 1);
+
+            p.pc++;
+            q_rest--;
+            st.reloj++;
+
+            out << "  - Instr[" << instrIndex << "] " << raw << "  | "
+                << a1 << ": " << before << " -> " << regRef(p,a1)
+                << "  | Quantum restante: " << q_rest << "\n";
+        }
+        else if (op=="JMP") {
+            int tgt=0;
+            if (!parseIntSafe(a1, tgt)) {
+                err << "  ! Destino JMP invalido en: " << raw << "\n"; break;
+            }
+            int oldPC = p.pc;
+            if (tgt < 0 || tgt >= static_cast<int>(prog.size())) {
+                err << "  ! JMP fuera de rango (" << tgt << "), proceso termina.\n";
+                p.pc = static_cast<int>(prog.size()); // fuerza fin
+            } else {
+                p.pc = tgt;
+            }
+
+            q_rest--;
+            st.reloj++;
+
+            out << "  - Instr[" << instrIndex << "] " << raw
+                << "  | PC: " << oldPC << " -> " << p.pc
+                << "  | Quantum restante: " << q_rest << "\n";
+        }
+        else if (op=="IO" || op=="SLEEP") {
+            int dur=0;
+            if (!parseIntSafe(a1, dur) || dur <= 0) {
+                err << "  ! Duracion invalida en: " << raw << "\n"; break;
+            }
+            p.pc++;
+            q_rest--;
+            st.reloj++;
+
+            // IO: el dispositivo atiende en orden FIFO; SLEEP: solo temporizador
+            long long inicio = st.reloj, fin;
+            if (op=="IO") {
+                inicio = std::max(st.reloj, st.dispositivoLibre);
+                st.dispositivoLibre = inicio + dur;
+            }
+            fin = inicio + dur;
+            res.bloqueado = true;
+            res.porIO = (op=="IO");
+            res.finBloqueo = fin;
+
+            out << "  - Instr[" << instrIndex << "] " << raw << "  | "
+                << (op=="IO" ? "E/S en dispositivo: t=" : "Dormido: t=")
+                << inicio << " -> t=" << fin
+                << "  | Quantum restante: " << q_rest << "\n";
+            emitir(instrIndex);
+            break;                           // el proceso cede la CPU
+        }
+        else if (op=="LOAD" || op=="STORE") {
+            if (!isReg(a1)) { err << "  ! Registro invalido en: " << raw << "\n"; break; }
+            long long dir=0;
+            if (isReg(a2)) { dir = regRef(p,a2); }
+            else {
+                int d=0;
+                if (!parseIntSafe(a2, d)) { err << "  ! Direccion invalida en: " << raw << "\n"; break; }
+                dir = d;
+            }
+            Registro valor = regRef(p,a1);
+            ResultadoAcceso acc = acceder(st, idx, op=="STORE", dir, valor);
+            if (!acc.valido) {
+                err << "  ! Violacion de segmento (direccion " << dir << "), proceso termina.\n";
+                p.pc = static_cast<int>(prog.size()); // fuerza fin
+            } else {
+                if (op=="LOAD") regRef(p,a1) = valor;
+                p.pc++;
+            }
+            q_rest--;
+            st.reloj++;
+
+            out << "  - Instr[" << instrIndex << "] " << raw << "  | ";
+            if (!acc.valido) out << "(violacion de segmento)";
+            else {
+                if (op=="LOAD") out << a1 << " <- M[" << dir << "] = " << valor;
+                else            out << "M[" << dir << "] <- " << a1 << " = " << valor;
+                out << " (pag " << acc.pagina << ", marco " << acc.marco
+                    << (acc.aciertoTLB ? ", TLB acierto" : ", TLB fallo")
+                    << (acc.falloPagina ? ", FALLO DE PAGINA" : "") << ")";
+            }
+            out << "  | Quantum restante: " << q_rest << "\n";
+        }
+        else if (op=="NOP") {
+            p.pc++;
+            q_rest--;
+            st.reloj++;
+            out << "  - Instr[" << instrIndex << "] " << raw
+                << "  | (sin efecto)"
+                << "  | Quantum restante: " << q_rest << "\n";
+        }
+        else {
+        
+            p.pc++;
+            q_rest--;
+            st.reloj++;
+            out << "  - Instr[" << instrIndex << "] " << raw
+                << "  | (desconocida→NOP)"
+                << "  | Quantum restante: " << q_rest << "\n";
+        }
+        emitir(instrIndex);
+    }
+    return res;
+}
+
+template <class A>
+static ResultadoRebanada rebanadaDecodificada(Proceso& p, int idx, const Programa& prog,
+                                              EstadoEjecucion& st, const CodigoNativo* nativo) {
+    using Reg = typename A::Tipo;
+    static_assert(std::is_same<Reg, Registro>::value, "el Alu debe coincidir con Proceso");
+    ResultadoRebanada res;
+    Reg* regs[3] = {&p.ax, &p.bx, &p.cx};
+    const int fin = static_cast<int>(prog.codigo.size());
+    const Instruccion* codigo = prog.codigo.data();
+    if (st.observador) nativo = nullptr;   // el código nativo no emite eventos
+
+    for (int q_rest = p.quantum; q_rest > 0 && p.pc < fin; --q_rest) {
+        if (nativo && nativo->entrada(p.pc)) {
+            long long presupuesto = q_rest;
+            if (st.limite >= 0) presupuesto = std::min(presupuesto, st.limite - st.instrucciones);
+            const long long hechas = nativo->ejecutar(p, presupuesto);
+            // Sin avance: el tramo no entra en lo que queda, el resto lo interpreta el bucle
+            if (hechas == 0) nativo = nullptr;
+            q_rest -= static_cast<int>(hechas);
+            st.reloj += hechas;
+            st.instrucciones += hechas;
+            if (q_rest == 0 || p.pc >= fin) break;
+        }
+        if (st.limite >= 0 && st.instrucciones >= st.limite) { res.limite = true; break; }
+        const int pcAntes = p.pc;
+        const Instruccion& ins = codigo[p.pc];
+        Reg& dst = *regs[ins.dst];
+        const Reg src = ins.src == kInmediato ? static_cast<Reg>(ins.inm) : *regs[ins.src];
+
+        switch (ins.op) {
+            case OpCode::ADD: dst = A::sumar(dst, src);       p.pc++; break;
+            case OpCode::SUB: dst = A::restar(dst, src);      p.pc++; break;
+            case OpCode::MUL: dst = A::multiplicar(dst, src); p.pc++; break;
+            case OpCode::INC: dst = A::sumar(dst, 1);         p.pc++; break;
+            case OpCode::JMP: p.pc = ins.inm; break;   // destino ya acotado al decodificar
+            case OpCode::IO: {
+                p.pc++;
+                st.reloj++;
+                long long inicio = std::max(st.reloj, st.dispositivoLibre);
+                st.dispositivoLibre = inicio + ins.inm;
+                res.bloqueado = true;
+                res.porIO = true;
+                res.finBloqueo = inicio + ins.inm;
+                st.instrucciones++;
+                if (st.observador) emitirEvento(st, p, pcAntes);
+                return res;
+            }
+            case OpCode::SLEEP:
+                p.pc++;
+                st.reloj++;
+                res.bloqueado = true;
+                res.finBloqueo = st.reloj + ins.inm;
+                st.instrucciones++;
+                if (st.observador) emitirEvento(st, p, pcAntes);
+                return res;
+            case OpCode::LOAD:
+            case OpCode::STORE: {
+                if (!st.memoria && !st.reproducirAccesos) { res.requiereMemoria = true; return res; }
+                Reg valor = dst;
+                ResultadoAcceso acc = acceder(st, idx, ins.op == OpCode::STORE, src, valor);
+                if (!acc.valido) { p.pc = fin; break; }
+                dst = valor;
+                p.pc++;
+                break;
+            }
+            case OpCode::NOP:
+            case OpCode::DESCONOCIDA:
+                p.pc++;
+                break;
+            case OpCode::INVALIDA:
+                return res;      // igual que el intérprete: cede la CPU sin avanzar
+        }
+        st.reloj++;
+        st.instrucciones++;
+        if (st.observador) emitirEvento(st, p, pcAntes);
+    }
+    return res;
+}
+
+ResultadoRebanada ejecutarRebanadaDecodificada(Proceso& p, int idx,
+                                               const Programa& prog,
+                                               EstadoEjecucion& st,
+                                               const CodigoNativo* nativo) {
+    return rebanadaDecodificada<Alu>(p, idx, prog, st, nativo);
+}
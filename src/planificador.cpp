@@ -11,12 +11,8 @@
  *
  * Funciones auxiliares:
  * - printSeparator: Imprime una línea separadora en consola.
- * - trim: Elimina espacios en blanco al inicio y final de una cadena.
- * - upper: Convierte una cadena a mayúsculas.
- * - regRef: Devuelve una referencia al registro solicitado de un proceso.
- * - isReg: Verifica si una cadena corresponde a un registro válido.
- * - parseIntSafe: Intenta convertir una cadena a entero de forma segura.
  * - printReadyQueue: Imprime el contenido de la cola de listos.
+ * - costoCambio: Calcula el costo de un cambio de contexto.
  *
  * Método principal:
  * - PlanificadorRoundRobin::schedule: Ejecuta la planificación Round-Robin sobre un conjunto de procesos
@@ -24,14 +20,44 @@
  *
  * Detalles de la simulación:
  * - Cada proceso tiene un quantum configurable.
- * - Se simulan instrucciones básicas de tipo ensamblador.
+ * - Se simulan instrucciones básicas de tipo ensamblador. La ejecución de cada quantum se
+ *   delega al motor seleccionado (motor.h): el intérprete de referencia o el decodificado.
  * - Se muestra el estado de los procesos y la cola de listos en cada paso.
  * - Se gestionan los cambios de contexto y la finalización de procesos.
+ * - Núcleo de eventos discretos: reloj lógico (1 tick por instrucción), IO y SLEEP
+ *   bloquean al proceso y programan su despertar en un min-heap de eventos. Si no
+ *   hay procesos listos, el reloj salta directamente al siguiente evento.
+ * - LOAD/STORE usan MemoriaVirtual (paginación, TLB y reemplazo); la TLB se vacía en cada
+ *   cambio de contexto y los marcos se liberan cuando el proceso termina.
+ * - Cada cambio de contexto cuesta un overhead fijo más una penalización de caché/TLB fríos
+ *   que decae con lo reciente que fue la última ejecución del proceso entrante; el costo
+ *   avanza el reloj lógico y se reporta en las métricas finales.
+ * - Los procesos se admiten en su instante de llegada. En modo flujo (simular) se leen de
+ *   una FuenteProcesos solo cuando el reloj alcanza su llegada y sus ranuras se reciclan al
+ *   terminar, por lo que la memoria depende de los procesos vivos y no del total.
+ * - Cada instrucción ejecutada se entrega como EventoTraza al observador configurado
+ *   (grabación/reproducción de trazas y pruebas diferenciales).
+ * - Motor PARALELO: al tomar un proceso sin rebanada precalculada se ejecutan a la vez, en
+ *   un pool de hilos, las rebanadas de él y de toda la cola de listos, cada una sobre una
+ *   copia del proceso con reloj relativo. El bucle Round-Robin no cambia: al llegar el turno
+ *   de cada proceso se aplica su rebanada (se desplazan los instantes de sus eventos y se
+ *   resuelve la E/S contra el dispositivo real). Las rebanadas que tocan memoria o que
+ *   cruzarían el tope de instrucciones se descartan y se ejecutan en serie en su turno.
+ * - Los programas llegan internados en un CatalogoProgramas (catalogo.h): los procesos con
+ *   el mismo programa comparten texto, código decodificado y código nativo.
+ * - Con el nivel JIT activo, cada programa se compila a código nativo (jit.h) después de
+ *   un umbral de instrucciones interpretadas (sumando todos sus procesos); desde entonces
+ *   sus rebanadas corren en nativo salvo IO/SLEEP/LOAD/STORE y los cortes de quantum.
+ * - Con un MonitorSimulacion configurado se publica cada ~100 ms una instantánea del estado
+ *   (sin bloqueos) que un hilo aparte sirve por un socket Unix.
+ * - Con una BitacoraRebanadas configurada se registra un resumen por rebanada, a partir
+ *   del cual se puede reconstruir después la traza detallada de cualquier tramo.
  *
  * @author
  * @date
  */
 #include "planificador.h"
+#include "hilos.h"
 #include <iostream>
 #include <cstring>
 #include <iomanip>
@@ -39,255 +65,647 @@
 #include <cctype>
 #include <sstream>
 #include <queue>
+#include <cmath>
+#include <memory>
+#include <vector>
 
-static void printSeparator(char ch='=', int n=60) {
-    for (int i=0;i<n;++i) std::cout << ch;
-    std::cout << "\n";
+static void printSeparator(std::ostream& os, char ch='=', int n=60) {
+    for (int i=0;i<n;++i) os << ch;
+    os << "\n";
 }
 
-static std::string trim(const std::string& s) {
-    size_t a = s.find_first_not_of(" \t\r\n");
-    size_t b = s.find_last_not_of(" \t\r\n");
-    if (a == std::string::npos) return "";
-    return s.substr(a, b - a + 1);
-}
-static std::string upper(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(),
-                   [](unsigned char c){ return std::toupper(c); });
-    return s;
-}
+// Evento de despertar: el proceso idx vuelve a LISTO en el instante 'tiempo'.
+// 'seq' desempata eventos simultáneos en orden de creación (FIFO).
+struct EventoDespertar {
+    long long tiempo;
+    long long seq;
+    int idx;
+    bool porIO;
+};
+struct CmpEvento {
+    bool operator()(const EventoDespertar& a, const EventoDespertar& b) const {
+        if (a.tiempo != b.tiempo) return a.tiempo > b.tiempo;
+        return a.seq > b.seq;
+    }
+};
+using ColaEventos = std::priority_queue<EventoDespertar, std::vector<EventoDespertar>, CmpEvento>;
 
-static int& regRef(Proceso& p, const std::string& r) {
-    if (r == "AX") return p.ax;
-    if (r == "BX") return p.bx;
-    return p.cx; // CX por defecto
-}
-static bool isReg(const std::string& r) {
-    return r=="AX" || r=="BX" || r=="CX";
+// Métricas de un proceso (ticks); ultimaSalida = -1 si nunca ejecutó (caché fría)
+struct MetricasProceso {
+    long long llegada = 0;
+    long long fin = -1;
+    long long cpu = 0;
+    long long bloqueado = 0;
+    long long overhead = 0;
+    long long ultimaSalida = -1;
+};
+
+// Rebanada precalculada por el motor paralelo (reloj relativo: 0 al empezar)
+struct Especulacion {
+    bool valida = false;
+    Proceso final{};                  // estado del proceso al terminar la rebanada
+    ResultadoRebanada res;            // finBloqueo relativo
+    long long ticks = 0;
+    long long instrucciones = 0;
+    std::vector<EventoTraza> eventos; // solo si hay observador; t relativo
+};
+
+struct ColectorEventos : ObservadorEventos {
+    std::vector<EventoTraza>* destino = nullptr;
+    void instruccion(const EventoTraza& ev) override { destino->push_back(ev); }
+};
+
+// Ejecuta aislada la rebanada del proceso p: sin memoria (se detiene ante LOAD/STORE), sin
+// tope y con el dispositivo de E/S libre (la espera real se calcula al aplicarla)
+static void especular(Especulacion& e, const Proceso& p, int idx, const Programa& prog,
+                      const CodigoNativo* nativo, bool conEventos) {
+    EstadoEjecucion st;
+    ColectorEventos col;
+    e.eventos.clear();
+    if (conEventos) {
+        col.destino = &e.eventos;
+        st.observador = &col;
+    }
+    e.final = p;
+    e.res = ejecutarRebanadaDecodificada(e.final, idx, prog, st, nativo);
+    e.ticks = st.reloj;
+    e.instrucciones = st.instrucciones;
+    e.valida = !e.res.requiereMemoria;
 }
-static bool parseIntSafe(const std::string& s, int& out) {
-    try {
-        size_t idx=0; int val = std::stoi(s, &idx);
-        if (idx != s.size()) return false;
-        out = val; return true;
-    } catch (...) { return false; }
+
+// Ticks que cuesta cargar un proceso inactivo desde hace 'inactivo' ticks (-1 = nunca ejecutó)
+static long long costoCambio(const ConfigCambioContexto& cfg, long long inactivo, long long& frio) {
+    double tibieza = 0.0;
+    if (inactivo >= 0 && cfg.vidaMedia > 0)
+        tibieza = std::exp2(-static_cast<double>(inactivo) / cfg.vidaMedia);
+    frio = std::llround(cfg.penalizacionFria * (1.0 - tibieza));
+    return cfg.costoFijo + frio;
 }
 
 // Imprime el contenido de la cola de listos
-static void printReadyQueue(const std::queue<int>& q, const std::vector<Proceso>& procesos) {
+static void printReadyQueue(std::ostream& os, const std::queue<int>& q,
+                            const std::vector<Proceso>& procesos) {
+    if (!os) return;   // salida desactivada: no copiar la cola
     std::queue<int> tmp = q;
-    std::cout << "  COLA (front→back): ";
+    os << "  COLA (front→back): ";
     bool first = true;
     while (!tmp.empty()) {
         int idx = tmp.front(); tmp.pop();
-        std::cout << (first ? "" : " -> ") << "P" << procesos[idx].pid;
+        os << (first ? "" : " -> ") << "P" << procesos[idx].pid;
         first = false;
     }
-    if (first) std::cout << "(vacía)";
-    std::cout << "\n";
+    if (first) os << "(vacía)";
+    os << "\n";
 }
 
 void PlanificadorRoundRobin::schedule(std::vector<Proceso>& procesos,
                                       const std::vector<std::vector<std::string>>& instrucciones) {
-    const int n = static_cast<int>(procesos.size());
-    int finished = 0;
+    CatalogoProgramas catalogo;
+    std::vector<IdPrograma> ids;
+    ids.reserve(instrucciones.size());
+    for (const auto& lineas : instrucciones) ids.push_back(catalogo.internar(lineas));
+    ejecutar(procesos, &catalogo, &ids, nullptr);
+}
 
-    // 1) Cabecera + listado inicial (incluye AX,BX,CX)
-    printSeparator('=');
-    std::cout << "PROCESOS E INSTRUCCIONES CARGADAS\n";
-    printSeparator('-');
-    for (int i = 0; i < n; ++i) {
-        std::cout << "  Proceso " << procesos[i].pid
-                  << " | PC=" << procesos[i].pc
-                  << " | Q=" << procesos[i].quantum
-                  << " | AX=" << procesos[i].ax
-                  << " | BX=" << procesos[i].bx
-                  << " | CX=" << procesos[i].cx
-                  << " | Instrucciones=" << instrucciones[i].size()
-                  << " | Estado=" << procesos[i].estado << "\n";
-    }
-    printSeparator('=');
-    std::cout << "\n";
+void PlanificadorRoundRobin::schedule(std::vector<Proceso>& procesos,
+                                      const CatalogoProgramas& catalogo,
+                                      const std::vector<IdPrograma>& programas) {
+    ejecutar(procesos, &catalogo, &programas, nullptr);
+}
+
+void PlanificadorRoundRobin::simular(FuenteProcesos& fuente) {
+    std::vector<Proceso> ranuras;
+    ejecutar(ranuras, nullptr, nullptr, &fuente);
+}
+
+void PlanificadorRoundRobin::ejecutar(std::vector<Proceso>& procesos,
+                                      const CatalogoProgramas* catalogoExterno,
+                                      const std::vector<IdPrograma>* programas,
+                                      FuenteProcesos* fuente) {
+    const bool enFlujo = (fuente != nullptr);
+    int n = static_cast<int>(procesos.size());
+    long long seqEventos = 0;
+    ColaEventos eventos;                 // procesos bloqueados, ordenados por despertar
+    MemoriaVirtual memoria(cfgMemoria_, n);
+    int ultimo = -1;                     // último proceso que tuvo la CPU
+    bool cpuUsada = false;               // el primer despacho no desaloja a nadie: sin costo
+
+    std::ostream nulo(nullptr);          // salida desactivada: descarta todo
+    std::ostream& out = salida_ == Salida::COMPLETA ? std::cout : nulo;
+    std::ostream& err = salida_ == Salida::COMPLETA ? std::cerr : nulo;
+    std::ostream& rep = salida_ == Salida::NINGUNA ? nulo : std::cout;   // reporte final
 
-    // 2) Construir COLA DE LISTOS (FIFO real)
+    EstadoEjecucion st;
+    st.limite = limite_;
+    st.memoria = &memoria;
+    st.observador = observador_;
+    st.out = &out;
+    st.err = &err;
+    long long& reloj = st.reloj;         // reloj lógico (ticks)
+
+    // Programa de cada ranura: un id en el catálogo del llamador o, en flujo, en uno propio
+    // que llena la fuente y del que se libera el programa de cada proceso que termina.
+    // Texto, código decodificado y análisis se comparten entre procesos con igual programa.
+    CatalogoProgramas propio;
+    const CatalogoProgramas& catalogo = enFlujo ? propio : *catalogoExterno;
+    std::vector<IdPrograma> programaDe;
+    if (!enFlujo) programaDe = *programas;
+    auto texto = [&](int i) -> const std::vector<std::string>& {
+        return catalogo.texto(programaDe[i]);
+    };
+    auto programa = [&](int i) -> const Programa& { return catalogo.programa(programaDe[i]); };
+    // Nivel JIT por programa (lo comparten sus procesos): instrucciones interpretadas hasta
+    // compilar (-1 = ya se intentó)
+    const bool jit = motor_ != Motor::REFERENCIA && jitUmbral_ >= 0;
+    std::vector<std::unique_ptr<CodigoNativo>> nativos(catalogo.capacidad());
+    std::vector<long long> interpretadas(catalogo.capacidad(), 0);
+    auto nativo = [&](int i) { return nativos[programaDe[i]].get(); };
+    bool limiteAlcanzado = false;
+    // Rebanadas seguidas que no ejecutaron nada ni movieron el reloj (operando inválido: el
+    // proceso cede sin avanzar). Si toda la cola de listos está así, el reloj no avanza más
+    // y nadie despierta ni llega: la simulación se repetiría para siempre.
+    long long sinAvance = 0;
+    bool estancada = false;
+
+    // Métricas por proceso (ticks)
+    std::vector<MetricasProceso> met(n);
+    long long tOciosa = 0, tCambios = 0, nCambios = 0;
+    long long tUtil = 0, completados = 0, sumaRetorno = 0, sumaEspera = 0;
+
+    // Llegadas pendientes: en modo vector, índices ordenados por llegada (estable);
+    // en flujo, un único proceso leído por adelantado.
+    std::vector<int> porLlegar;
+    size_t sigLlegada = 0;
+    Proceso adelantado{};
+    IdPrograma progAdelantado = -1;
+    bool hayAdelantado = false;
+    std::vector<int> libres;             // ranuras recicladas (solo en flujo)
     std::queue<int> ready;
-    for (int i = 0; i < n; ++i) {
-        if (procesos[i].pc < static_cast<int>(instrucciones[i].size())) {
-            std::strcpy(procesos[i].estado, "Listo");
+    std::vector<int> enBitacora(n, -1);  // índice de cada ranura en la bitácora
+    std::vector<Especulacion> espec(n);  // motor paralelo: rebanada precalculada por ranura
+    std::unique_ptr<PoolHilos> pool;
+    if (motor_ == Motor::PARALELO) pool.reset(new PoolHilos(hilos_));
+    std::vector<int> lote;
+    long long admitidos = 0;
+    if (bitacora_)
+        for (int i = 0; i < n; ++i) enBitacora[i] = bitacora_->registrarProceso(procesos[i], texto(i));
+
+    auto hayLlegada = [&]() {
+        return enFlujo ? hayAdelantado : sigLlegada < porLlegar.size();
+    };
+    auto tLlegada = [&]() -> long long {
+        return enFlujo ? adelantado.llegada : procesos[porLlegar[sigLlegada]].llegada;
+    };
+    auto leerAdelantado = [&]() {
+        hayAdelantado = fuente->siguiente(adelantado, propio, progAdelantado);
+        nativos.resize(propio.capacidad());
+        interpretadas.resize(propio.capacidad(), 0);
+    };
+
+    // Registra la finalización del proceso i en el instante t
+    auto registrarFin = [&](int i, long long t) {
+        Proceso& fp = procesos[i];
+        std::strcpy(fp.estado, "Terminado");
+        MetricasProceso& m = met[i];
+        m.fin = t;
+        const long long retorno = t - m.llegada;
+        completados++;
+        sumaRetorno += retorno;
+        sumaEspera += retorno - m.cpu - m.bloqueado - m.overhead;
+        memoria.liberarProceso(i);
+    };
+    auto liberarRanura = [&](int i) {
+        if (!enFlujo) return;
+        libres.push_back(i);
+        if (ultimo == i) ultimo = -1;    // la ranura reciclada será otro proceso
+        const IdPrograma id = programaDe[i];
+        if (propio.liberar(id)) {        // ningún proceso vivo lo usa: su id se reutilizará
+            nativos[id].reset();
+            interpretadas[id] = 0;
+        }
+    };
+
+    // Instantánea para el monitor: contadores y los procesos vivos con más CPU
+    auto publicar = [&](bool terminada) {
+        InstantaneaSimulacion s;
+        s.reloj = reloj;
+        s.listos = static_cast<long long>(ready.size());
+        s.bloqueados = static_cast<long long>(eventos.size());
+        s.admitidos = admitidos;
+        s.completados = completados;
+        s.instrucciones = st.instrucciones;
+        s.terminada = terminada;
+        for (int i = 0; i < n; ++i) {
+            if (met[i].fin >= 0 || met[i].cpu == 0) continue;
+            int k = s.nTop < kTopMonitor ? s.nTop++ : kTopMonitor;
+            if (k == kTopMonitor && met[i].cpu <= s.top[k - 1].cpu) continue;
+            if (k == kTopMonitor) k--;
+            for (; k > 0 && s.top[k - 1].cpu < met[i].cpu; --k) s.top[k] = s.top[k - 1];
+            s.top[k] = {procesos[i].pid, met[i].cpu};
+        }
+        monitor_->publicar(s);
+    };
+    if (monitor_) monitor_->reiniciar();   // en el menú el monitor se reutiliza entre corridas
+
+    // Admite el siguiente proceso que llega: lo encola como LISTO (o lo termina si no tiene código)
+    auto admitir = [&]() {
+        int i;
+        if (enFlujo) {
+            if (!libres.empty()) { i = libres.back(); libres.pop_back(); }
+            else {
+                i = n++;
+                procesos.emplace_back();
+                programaDe.emplace_back();
+                met.emplace_back();
+                enBitacora.emplace_back(-1);
+                espec.emplace_back();
+                memoria.asegurarProcesos(n);
+            }
+            procesos[i] = adelantado;
+            programaDe[i] = progAdelantado;
+            if (bitacora_) enBitacora[i] = bitacora_->registrarProceso(procesos[i], texto(i));
+            leerAdelantado();
+        } else {
+            i = porLlegar[sigLlegada++];
+        }
+        met[i] = MetricasProceso{};
+        met[i].llegada = procesos[i].llegada;
+        admitidos++;
+        Proceso& ap = procesos[i];
+        if (ap.pc < static_cast<int>(texto(i).size())) {
+            std::strcpy(ap.estado, "Listo");
             ready.push(i);
+            out << "  ➕ Proceso " << ap.pid << " LLEGA en t=" << met[i].llegada
+                << " (Q=" << ap.quantum << ", Instrucciones=" << texto(i).size()
+                << "). Se ENCOLA al final.\n";
         } else {
-            std::strcpy(procesos[i].estado, "Terminado");
-            finished++;
+            registrarFin(i, met[i].llegada);
+            out << "  ✔ Proceso " << ap.pid << " LLEGA en t=" << met[i].llegada
+                << " sin instrucciones: TERMINADO.\n";
+            liberarRanura(i);
         }
-    }
+        if (monitor_ && monitor_->toca()) publicar(false);   // admisiones masivas sin rebanadas
+    };
 
-    std::cout << "COLA INICIAL:\n";
-    printReadyQueue(ready, procesos);
-    std::cout << "\n";
+    // 1) Cabecera + listado inicial (incluye AX,BX,CX)
+    if (enFlujo) {
+        printSeparator(out, '=');
+        out << "ADMISION EN FLUJO (los procesos se leen al llegar su instante)\n";
+        printSeparator(out, '=');
+        out << "\n";
+        leerAdelantado();
+    } else {
+        printSeparator(out, '=');
+        out << "PROCESOS E INSTRUCCIONES CARGADAS\n";
+        printSeparator(out, '-');
+        for (int i = 0; i < n; ++i) {
+            // Conteos exactos del análisis estático desde el PC inicial (-1 = no termina)
+            const AnalisisPrograma& an = catalogo.analisis(programaDe[i]);
+            const int pc = procesos[i].pc;
+            const bool dentro = pc >= 0 && pc < static_cast<int>(an.restantes.size());
+            const long long total = dentro ? an.restantes[pc] : 0;
+            const long long rafaga = dentro ? an.rafaga[pc] : 0;
+            out << "  Proceso " << procesos[i].pid
+                << " | PC=" << procesos[i].pc
+                << " | Q=" << procesos[i].quantum
+                << " | AX=" << procesos[i].ax
+                << " | BX=" << procesos[i].bx
+                << " | CX=" << procesos[i].cx
+                << " | Instrucciones=" << texto(i).size()
+                << " | Ejecutara=" << (total < 0 ? std::string("sin fin") : std::to_string(total))
+                << " | Rafaga=" << (rafaga < 0 ? std::string("sin fin") : std::to_string(rafaga))
+                << " | Estado=" << procesos[i].estado;
+            if (procesos[i].llegada > 0) out << " | Llegada=" << procesos[i].llegada;
+            out << "\n";
+        }
+        printSeparator(out, '=');
+        out << "\n";
+
+        // 2) Construir COLA DE LISTOS (FIFO real) con los que llegan en t=0
+        for (int i = 0; i < n; ++i) {
+            if (procesos[i].llegada > 0) {
+                std::strcpy(procesos[i].estado, "Nuevo");
+                porLlegar.push_back(i);
+            } else if (procesos[i].pc < static_cast<int>(texto(i).size())) {
+                std::strcpy(procesos[i].estado, "Listo");
+                ready.push(i);
+            } else {
+                registrarFin(i, 0);
+            }
+        }
+        std::stable_sort(porLlegar.begin(), porLlegar.end(), [&](int a, int b) {
+            return procesos[a].llegada < procesos[b].llegada;
+        });
+        admitidos = n - static_cast<long long>(porLlegar.size());
 
-    if (ready.empty()) {
-        printSeparator('=');
-        std::cout << "PLANIFICACION COMPLETA\n";
-        printSeparator('=');
-        return;
+        out << "COLA INICIAL:\n";
+        printReadyQueue(out, ready, procesos);
+        out << "\n";
     }
 
-    printSeparator('=');
-    std::cout << "INICIO DE PLANIFICACION (Round-Robin)\n";
-    printSeparator('=');
+    printSeparator(out, '=');
+    out << "INICIO DE PLANIFICACION (Round-Robin)\n";
+    printSeparator(out, '=');
+
+    // Procesa en orden temporal llegadas y despertares ya ocurridos (tiempo <= reloj).
+    // A igual instante, la llegada se atiende antes que el despertar.
+    auto despertar = [&]() {
+        while (true) {
+            const bool llega = hayLlegada() && tLlegada() <= reloj;
+            const bool despierta = !eventos.empty() && eventos.top().tiempo <= reloj;
+            if (!llega && !despierta) break;
+            if (llega && (!despierta || tLlegada() <= eventos.top().tiempo)) {
+                admitir();
+                continue;
+            }
+            EventoDespertar ev = eventos.top();
+            eventos.pop();
+            Proceso &bp = procesos[ev.idx];
+            if (bp.pc >= static_cast<int>(texto(ev.idx).size())) {
+                registrarFin(ev.idx, ev.tiempo);
+                out << "  ✔ Proceso " << bp.pid << " completa su "
+                    << (ev.porIO ? "E/S" : "espera") << " en t=" << ev.tiempo
+                    << " y ha TERMINADO todas sus instrucciones.\n";
+                liberarRanura(ev.idx);
+            } else {
+                std::strcpy(bp.estado, "Listo");
+                ready.push(ev.idx);
+                out << "  ↺ Proceso " << bp.pid << " DESPIERTA en t=" << ev.tiempo
+                    << " (" << (ev.porIO ? "fin de E/S" : "fin de SLEEP")
+                    << "). Se ENCOLA al final.\n";
+            }
+        }
+    };
 
     // 3) Bucle principal: siempre tomar del FRONT y reencolar al BACK si no terminó
-    while (!ready.empty()) {
+    while (!ready.empty() || !eventos.empty() || hayLlegada()) {
+        if (ready.empty()) {
+            // CPU ociosa: el reloj salta al siguiente evento en lugar de avanzar tick a tick
+            long long siguiente = eventos.empty() ? tLlegada() : eventos.top().tiempo;
+            if (hayLlegada()) siguiente = std::min(siguiente, tLlegada());
+            siguiente = std::max(siguiente, reloj);
+            printSeparator(out, '.');
+            out << "CPU OCIOSA | t=" << reloj << " -> t=" << siguiente << "\n";
+            printSeparator(out, '.');
+            tOciosa += siguiente - reloj;
+            reloj = siguiente;
+            despertar();
+            printReadyQueue(out, ready, procesos);
+            out << "\n";
+            continue;
+        }
+
         int idx = ready.front();
         ready.pop();
-        Proceso &p = procesos[idx];
-
-        printSeparator('.');
-        std::cout << "EJECUTANDO PROCESO " << p.pid << " | "
-                  << "PC=" << p.pc
-                  << " | AX=" << p.ax
-                  << " | BX=" << p.bx
-                  << " | CX=" << p.cx
-                  << " | Q=" << p.quantum << "\n";
-        printSeparator('.');
-
-        int q_rest = p.quantum;
-
-        while (q_rest > 0 && p.pc < static_cast<int>(instrucciones[idx].size())) {
-            int instrIndex = p.pc;               // PC antes de ejecutar
-            std::string raw = trim(instrucciones[idx][p.pc]);
-            std::string s = upper(raw);
-
-            // Parse op y operandos
-            std::string op, rest, a1, a2;
-            {
-                std::istringstream iss(s);
-                iss >> op;
-                std::getline(iss, rest);
-                rest = trim(rest);
-                size_t cpos = rest.find(',');
-                if (cpos != std::string::npos) {
-                    a1 = trim(rest.substr(0,cpos));
-                    a2 = trim(rest.substr(cpos+1));
-                } else {
-                    a1 = trim(rest);
-                }
-            }
-
-            if (op=="ADD" || op=="SUB" || op=="MUL") {
-                if (!isReg(a1)) { std::cerr << "  ! Destino invalido en: " << raw << "\n"; break; }
-                int valSrc=0; bool srcIsImm=false;
-                if (isReg(a2)) { valSrc = regRef(p,a2); }
-                else {
-                    if (!parseIntSafe(a2, valSrc)) { std::cerr << "  ! Operando invalido en: " << raw << "\n"; break; }
-                    srcIsImm = true;
-                }
-                int before = regRef(p,a1);
-                if (op=="ADD") regRef(p,a1) = before + valSrc;
-                else if (op=="SUB") regRef(p,a1) = before - valSrc;
-                else regRef(p,a1) = before * valSrc;
-
-                int after = regRef(p,a1);
-                p.pc++;        // avanzamos a la siguiente instrucción
-                q_rest--;      // consumimos quantum
-
-                std::cout << "  - Instr[" << instrIndex << "] " << raw << "  | "
-                          << a1 << ": " << before
-                          << (op=="ADD"? " + " : (op=="SUB"? " - " : " * "))
-                          << (srcIsImm? std::to_string(valSrc) : a2+"("+std::to_string(valSrc)+")")
-                          << " = " << after
-                          << "  | Quantum restante: " << q_rest << "\n";
+        const long long relojDespacho = reloj;
+        if (idx != ultimo && cpuUsada) {
+            memoria.cambioContexto(idx);
+            long long frio = 0;
+            long long inactivo = met[idx].ultimaSalida < 0 ? -1 : reloj - met[idx].ultimaSalida;
+            long long costo = costoCambio(cfgCambio_, inactivo, frio);
+            nCambios++;
+            if (costo > 0) {
+                out << "  ⇄ Costo de cambio de contexto a P" << procesos[idx].pid
+                    << ": fijo=" << cfgCambio_.costoFijo << " + frio=" << frio
+                    << (inactivo < 0 ? " (nunca ejecuto)"
+                                     : " (inactivo " + std::to_string(inactivo) + " ticks)")
+                    << " = " << costo << " ticks | t=" << reloj << " -> t=" << reloj + costo
+                    << "\n";
+                reloj += costo;
+                tCambios += costo;
+                met[idx].overhead += costo;
             }
-            else if (op=="INC") {
-                if (!isReg(a1)) { std::cerr << "  ! Registro invalido en: " << raw << "\n"; break; }
-                int before = regRef(p,a1);
-                regRef(p,a1) = before + 1;
+        }
+        ultimo = idx;
+        cpuUsada = true;
+        const long long inicioRebanada = reloj;
 
-                p.pc++;
-                q_rest--;
+        {
+            const Proceso &p = procesos[idx];
+            printSeparator(out, '.');
+            out << "EJECUTANDO PROCESO " << p.pid << " | "
+                << "t=" << reloj
+                << " | PC=" << p.pc
+                << " | AX=" << p.ax
+                << " | BX=" << p.bx
+                << " | CX=" << p.cx
+                << " | Q=" << p.quantum << "\n";
+            printSeparator(out, '.');
+        }
 
-                std::cout << "  - Instr[" << instrIndex << "] " << raw << "  | "
-                          << a1 << ": " << before << " -> " << regRef(p,a1)
-                          << "  | Quantum restante: " << q_rest << "\n";
+        if (bitacora_) bitacora_->iniciarRebanada(enBitacora[idx], procesos[idx], st);
+        const long long instrAntes = st.instrucciones;
+        ResultadoRebanada res;
+        if (motor_ == Motor::PARALELO) {
+            if (!espec[idx].valida) {
+                // Nuevo lote: este proceso y todos los que esperan en la cola
+                lote.assign(1, idx);
+                for (std::queue<int> tmp = ready; !tmp.empty(); tmp.pop())
+                    if (!espec[tmp.front()].valida) lote.push_back(tmp.front());
+                const bool conEventos = observador_ != nullptr;
+                pool->paraCada(lote.size(), [&](size_t k) {
+                    const int i = lote[k];
+                    especular(espec[i], procesos[i], i, programa(i), nativo(i), conEventos);
+                });
             }
-            else if (op=="JMP") {
-                int tgt=0;
-                if (!parseIntSafe(a1, tgt)) {
-                    std::cerr << "  ! Destino JMP invalido en: " << raw << "\n"; break;
+            Especulacion& e = espec[idx];
+            // Con el tope a menos de una rebanada, el corte exacto lo decide la ejecución en serie
+            if (e.valida && (st.limite < 0 || st.instrucciones + e.instrucciones < st.limite)) {
+                const long long base = reloj;
+                if (observador_) {
+                    for (EventoTraza ev : e.eventos) {
+                        ev.t += base;
+                        observador_->instruccion(ev);
+                    }
                 }
-                int oldPC = p.pc;
-                if (tgt < 0 || tgt >= static_cast<int>(instrucciones[idx].size())) {
-                    std::cerr << "  ! JMP fuera de rango (" << tgt << "), proceso termina.\n";
-                    p.pc = static_cast<int>(instrucciones[idx].size()); // fuerza fin
-                } else {
-                    p.pc = tgt;
+                procesos[idx] = e.final;
+                reloj += e.ticks;
+                st.instrucciones += e.instrucciones;
+                res = e.res;
+                if (res.bloqueado && res.porIO) {
+                    // La E/S pedida en el último tick espera al dispositivo real (FIFO)
+                    const long long inicio = std::max(reloj, st.dispositivoLibre);
+                    res.finBloqueo = inicio + (e.res.finBloqueo - e.ticks);
+                    st.dispositivoLibre = res.finBloqueo;
+                } else if (res.bloqueado) {
+                    res.finBloqueo += base;
                 }
-
-                q_rest--;
-
-                std::cout << "  - Instr[" << instrIndex << "] " << raw
-                          << "  | PC: " << oldPC << " -> " << p.pc
-                          << "  | Quantum restante: " << q_rest << "\n";
-            }
-            else if (op=="NOP") {
-                p.pc++;
-                q_rest--;
-                std::cout << "  - Instr[" << instrIndex << "] " << raw
-                          << "  | (sin efecto)"
-                          << "  | Quantum restante: " << q_rest << "\n";
+            } else {
+                res = ejecutarRebanadaDecodificada(procesos[idx], idx, programa(idx), st,
+                                                   nativo(idx));
             }
-            else {
-            
-                p.pc++;
-                q_rest--;
-                std::cout << "  - Instr[" << instrIndex << "] " << raw
-                          << "  | (desconocida→NOP)"
-                          << "  | Quantum restante: " << q_rest << "\n";
+            e.valida = false;
+        } else {
+            res = (motor_ == Motor::DECODIFICADO)
+                ? ejecutarRebanadaDecodificada(procesos[idx], idx, programa(idx), st,
+                                               nativo(idx))
+                : ejecutarRebanadaReferencia(procesos[idx], idx, texto(idx), st);
+        }
+        if (jit && interpretadas[programaDe[idx]] >= 0) {
+            const IdPrograma id = programaDe[idx];
+            interpretadas[id] += st.instrucciones - instrAntes;
+            if (interpretadas[id] >= jitUmbral_) {
+                nativos[id] = compilarNativo(catalogo.programa(id));
+                interpretadas[id] = -1;
             }
         }
+        if (bitacora_) bitacora_->terminarRebanada(procesos[idx], st, res.limite);
+        if (res.bloqueado) {
+            eventos.push({res.finBloqueo, seqEventos++, idx, res.porIO});
+            met[idx].bloqueado += res.finBloqueo - reloj;
+        }
+
+        met[idx].cpu += reloj - inicioRebanada;
+        met[idx].ultimaSalida = reloj;
+        tUtil += reloj - inicioRebanada;
 
-        // 4) Post-quantum: decidir si termina o vuelve a la cola
-        if (p.pc >= static_cast<int>(instrucciones[idx].size())) {
-            std::strcpy(p.estado, "Terminado");
-            finished++;
-            std::cout << "  ✔ Proceso " << p.pid << " ha TERMINADO todas sus instrucciones.\n";
+        // 4) Post-quantum: decidir si se bloquea, termina o vuelve a la cola.
+        //    Los procesos que llegan o despiertan durante el quantum se encolan antes que el
+        //    expulsado. En flujo, despertar() puede ampliar 'procesos': no guardar referencias.
+        if (res.limite) {
+            limiteAlcanzado = true;
+            out << "  ⚠ LIMITE de " << limite_ << " instrucciones alcanzado. Se detiene la simulacion.\n\n";
+            break;
+        }
+        bool terminado = false;
+        if (res.bloqueado) {
+            std::strcpy(procesos[idx].estado, "Bloqueado");
+            out << "  ⛔ Proceso " << procesos[idx].pid << " BLOQUEADO hasta t="
+                << res.finBloqueo << ".\n";
+            despertar();
+            printReadyQueue(out, ready, procesos);
+        } else if (procesos[idx].pc >= static_cast<int>(texto(idx).size())) {
+            registrarFin(idx, reloj);
+            terminado = true;
+            out << "  ✔ Proceso " << procesos[idx].pid << " ha TERMINADO todas sus instrucciones.\n";
+            despertar();
         } else {
-            std::strcpy(p.estado, "Listo");
-            std::cout << "  ⏳ Quantum AGOTADO para Proceso " << p.pid << ". Se ENCOLA al final.\n";
+            despertar();
+            std::strcpy(procesos[idx].estado, "Listo");
+            out << "  ⏳ Quantum AGOTADO para Proceso " << procesos[idx].pid << ". Se ENCOLA al final.\n";
             ready.push(idx);
-            printReadyQueue(ready, procesos);
+            printReadyQueue(out, ready, procesos);
+        }
+        out << "\n";
+        if (!res.bloqueado && !terminado && reloj == relojDespacho
+            && st.instrucciones == instrAntes) {
+            if (++sinAvance > static_cast<long long>(ready.size())) {
+                estancada = true;
+                out << "  ⚠ Ningun proceso listo puede avanzar (operandos invalidos) en t=" << reloj
+                    << ". Se detiene la simulacion.\n\n";
+                break;
+            }
+        } else {
+            sinAvance = 0;
         }
-        std::cout << "\n";
 
         // 5) Cambio de contexto (si hay alguien listo)
         if (!ready.empty()) {
-            Proceso &np = procesos[ready.front()];
-            printSeparator('-');
-            std::cout << "CAMBIO DE CONTEXTO\n";
-            printSeparator('-');
-            std::cout << "  Guardando [P" << p.pid << "]: PC=" << p.pc
-                      << ", AX=" << p.ax << ", BX=" << p.bx << ", CX=" << p.cx
-                      << ", Estado=" << p.estado << "\n";
-            std::cout << "  Cargando  [P" << np.pid << "]: PC=" << np.pc
-                      << ", AX=" << np.ax << ", BX=" << np.bx << ", CX=" << np.cx
-                      << ", Estado=" << np.estado << "\n\n";
+            const Proceso &p = procesos[idx];
+            const Proceso &np = procesos[ready.front()];
+            printSeparator(out, '-');
+            out << "CAMBIO DE CONTEXTO\n";
+            printSeparator(out, '-');
+            out << "  Guardando [P" << p.pid << "]: PC=" << p.pc
+                << ", AX=" << p.ax << ", BX=" << p.bx << ", CX=" << p.cx
+                << ", Estado=" << p.estado << "\n";
+            out << "  Cargando  [P" << np.pid << "]: PC=" << np.pc
+                << ", AX=" << np.ax << ", BX=" << np.bx << ", CX=" << np.cx
+                << ", Estado=" << np.estado << "\n\n";
         }
+        // La ranura de un proceso terminado se recicla recién después de mostrarlo
+        if (terminado) liberarRanura(idx);
+        if (monitor_ && monitor_->toca()) publicar(false);
     }
+    if (monitor_) publicar(true);
 
     // 6) Cierre
-    printSeparator('=');
-    std::cout << "PLANIFICACION COMPLETA\n";
-    printSeparator('=');
-
-    std::cout << "\nESTADOS FINALES DE PROCESOS\n";
-    printSeparator('-');
-    for (const auto& p : procesos) {
-        std::cout << "  Proceso " << p.pid
-                  << " | PC=" << p.pc
-                  << " | AX=" << p.ax
-                  << " | BX=" << p.bx
-                  << " | CX=" << p.cx
-                  << " | Estado=" << p.estado << "\n";
+    printSeparator(rep, '=');
+    rep << (limiteAlcanzado || estancada ? "PLANIFICACION INTERRUMPIDA" : "PLANIFICACION COMPLETA")
+        << " | t=" << reloj << "\n";
+    if (estancada) rep << "SIN AVANCE: todos los procesos listos se detienen en un operando invalido\n";
+    // Una carga cortada por una línea o un programa inválido no debe pasar por completa
+    const std::string corte = enFlujo ? fuente->interrupcion() : std::string();
+    if (!corte.empty()) rep << "ADMISION INTERRUMPIDA: " << corte << "\n";
+    printSeparator(rep, '=');
+
+    if (!enFlujo) {
+        rep << "\nESTADOS FINALES DE PROCESOS\n";
+        printSeparator(rep, '-');
+        for (int i = 0; i < n; ++i) {
+            const Proceso& p = procesos[i];
+            rep << "  Proceso " << p.pid
+                << " | PC=" << p.pc
+                << " | AX=" << p.ax
+                << " | BX=" << p.bx
+                << " | CX=" << p.cx
+                << " | Estado=" << p.estado
+                << " | Fin t=" << met[i].fin << "\n";
+        }
+        printSeparator(rep, '-');
+    }
+
+    rep << "\nMETRICAS (ticks)\n";
+    printSeparator(rep, '-');
+    if (!enFlujo) {
+        for (int i = 0; i < n; ++i) {
+            const MetricasProceso& m = met[i];
+            const long long retorno = m.fin - m.llegada;
+            rep << "  Proceso " << procesos[i].pid;
+            if (m.fin < 0) {
+                rep << " | (no termino) | CPU=" << m.cpu << " | Bloqueado=" << m.bloqueado
+                    << " | Overhead CC=" << m.overhead << "\n";
+                continue;
+            }
+            rep << " | Retorno=" << retorno
+                << " | CPU=" << m.cpu
+                << " | Bloqueado=" << m.bloqueado
+                << " | Espera=" << retorno - m.cpu - m.bloqueado - m.overhead
+                << " | Overhead CC=" << m.overhead << "\n";
+        }
+    }
+    const double total = reloj > 0 ? static_cast<double>(reloj) : 1.0;
+    rep << std::fixed << std::setprecision(1);
+    if (completados > 0) {
+        rep << "  Procesos completados=" << completados
+            << " | Retorno promedio=" << static_cast<double>(sumaRetorno) / completados
+            << " | Espera promedio=" << static_cast<double>(sumaEspera) / completados << "\n";
+    }
+    rep << "  Tiempo total=" << reloj
+        << " | CPU util=" << tUtil << " (" << 100.0 * tUtil / total << "%)"
+        << " | CPU ociosa=" << tOciosa << "\n"
+        << "  Cambios de contexto=" << nCambios
+        << " | Overhead=" << tCambios << " (" << 100.0 * tCambios / total << "%)\n";
+    rep.unsetf(std::ios::floatfield);
+    rep << std::setprecision(6);
+    printSeparator(rep, '-');
+
+    const EstadisticasMemoria& ms = memoria.estadisticas();
+    if (ms.accesos > 0) {
+        const ConfigMemoria& mc = memoria.config();
+        rep << "\nESTADISTICAS DE MEMORIA (" << nombrePolitica(mc.politica)
+            << ", " << mc.marcos << " marcos x " << mc.tamPagina << " palabras, TLB "
+            << mc.entradasTLB << " entradas)\n";
+        printSeparator(rep, '-');
+        rep << std::fixed << std::setprecision(1)
+            << "  Accesos=" << ms.accesos
+            << " | Aciertos TLB=" << ms.aciertosTLB
+            << " (" << 100.0 * ms.aciertosTLB / ms.accesos << "%)"
+            << " | Fallos TLB=" << ms.fallosTLB << "\n"
+            << "  Fallos de pagina=" << ms.fallosPagina
+            << " (" << 100.0 * ms.fallosPagina / ms.accesos << "%)"
+            << " | Reemplazos=" << ms.reemplazos
+            << " | Escrituras a swap=" << ms.escriturasSwap
+            << " | Vaciados de TLB=" << ms.vaciadosTLB << "\n";
+        rep.unsetf(std::ios::floatfield);
+        rep << std::setprecision(6);
+        if (!enFlujo) {
+            for (int i = 0; i < n; ++i) {
+                if (memoria.fallosPagina(i) > 0)
+                    rep << "  Proceso " << procesos[i].pid
+                        << " | Fallos de pagina=" << memoria.fallosPagina(i) << "\n";
+            }
+        }
+        printSeparator(rep, '-');
     }
-    printSeparator('-');
 }
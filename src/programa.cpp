@@ -0,0 +1,98 @@
+
+/**
+ * @file programa.cpp
+ * @brief Decodificación de programas de texto a instrucciones compactas.
+ *
+ * El análisis de cada línea sigue exactamente al intérprete de referencia (motor.cpp):
+ * mayúsculas, separación del opcode y de los operandos por la primera coma, registros
+ * AX/BX/CX y enteros con std::stoi. Así ambos motores producen la misma ejecución.
+ * Los JMP fuera de rango se resuelven aquí al índice de fin, una sola vez por programa.
+ */
+#include "programa.h"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+static std::string trim(const std::string& s) {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    size_t b = s.find_last_not_of(" \t\r\n");
+    if (a == std::string::npos) return "";
+    return s.substr(a, b - a + 1);
+}
+static std::string upper(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c){ return std::toupper(c); });
+    return s;
+}
+// Índice del registro (0=AX, 1=BX, 2=CX) o -1 si no es registro
+static int regIndex(const std::string& r) {
+    if (r == "AX") return 0;
+    if (r == "BX") return 1;
+    if (r == "CX") return 2;
+    return -1;
+}
+static bool parseIntSafe(const std::string& s, int& out) {
+    try {
+        size_t idx=0; int val = std::stoi(s, &idx);
+        if (idx != s.size()) return false;
+        out = val; return true;
+    } catch (...) { return false; }
+}
+
+static Instruccion decodificarLinea(const std::string& linea) {
+    Instruccion ins{OpCode::INVALIDA, 0, kInmediato, 0};
+    std::string s = upper(trim(linea));
+
+    std::string op, rest, a1, a2;
+    {
+        std::istringstream iss(s);
+        iss >> op;
+        std::getline(iss, rest);
+        rest = trim(rest);
+        size_t cpos = rest.find(',');
+        if (cpos != std::string::npos) {
+            a1 = trim(rest.substr(0,cpos));
+            a2 = trim(rest.substr(cpos+1));
+        } else {
+            a1 = trim(rest);
+        }
+    }
+
+    if (op=="ADD" || op=="SUB" || op=="MUL" || op=="LOAD" || op=="STORE") {
+        int d = regIndex(a1);
+        if (d < 0) return ins;
+        int r = regIndex(a2);
+        if (r < 0 && !parseIntSafe(a2, ins.inm)) return ins;
+        ins.dst = static_cast<uint8_t>(d);
+        ins.src = r < 0 ? kInmediato : static_cast<uint8_t>(r);
+        ins.op = op=="ADD" ? OpCode::ADD : op=="SUB" ? OpCode::SUB : op=="MUL" ? OpCode::MUL
+               : op=="LOAD" ? OpCode::LOAD : OpCode::STORE;
+    } else if (op=="INC") {
+        int d = regIndex(a1);
+        if (d < 0) return ins;
+        ins.dst = static_cast<uint8_t>(d);
+        ins.op = OpCode::INC;
+    } else if (op=="JMP") {
+        if (!parseIntSafe(a1, ins.inm)) return ins;
+        ins.op = OpCode::JMP;
+    } else if (op=="IO" || op=="SLEEP") {
+        if (!parseIntSafe(a1, ins.inm) || ins.inm <= 0) return ins;
+        ins.op = op=="IO" ? OpCode::IO : OpCode::SLEEP;
+    } else if (op=="NOP") {
+        ins.op = OpCode::NOP;
+    } else {
+        ins.op = OpCode::DESCONOCIDA;
+    }
+    return ins;
+}
+
+Programa decodificarPrograma(const std::vector<std::string>& lineas) {
+    Programa prog;
+    prog.codigo.reserve(lineas.size());
+    for (const auto& l : lineas) prog.codigo.push_back(decodificarLinea(l));
+    // Destinos de JMP inexistentes → fin del programa (así el motor no revisa el rango)
+    const int fin = static_cast<int>(prog.codigo.size());
+    for (Instruccion& ins : prog.codigo)
+        if (ins.op == OpCode::JMP && (ins.inm < 0 || ins.inm >= fin)) ins.inm = fin;
+    return prog;
+}
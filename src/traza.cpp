@@ -0,0 +1,164 @@
+
+/**
+ * @file traza.cpp
+ * @brief Implementación de la grabación y verificación de trazas binarias de eventos.
+ *
+ * Los registros tienen tamaño fijo, por lo que la verificación lee la traza grabada
+ * secuencialmente y compara evento a evento sin cargarla completa en memoria. El ancho
+ * y la semántica de los registros de la compilación quedan escritos en la cabecera.
+ */
+#include "traza.h"
+#include "registro.h"
+#include <cstring>
+
+static const char kMagia[8] = {'S','I','M','T','R','A','Z','A'};
+static const uint32_t kVersion = 2;
+static const uint32_t kBytesRegistro = sizeof(Registro);
+static const uint32_t kSemantica = Alu::kSaturar ? 1 : 0;
+static const size_t kTamCabecera = 8 + 4 * 3;
+static const size_t kTamEvento = 8 + 4 * 3 + 3 * kBytesRegistro;
+
+// Serialización little-endian independiente del host
+static void put(unsigned char*& p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) *p++ = static_cast<unsigned char>(v >> (8 * i));
+}
+static uint64_t get(const unsigned char*& p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= static_cast<uint64_t>(*p++) << (8 * i);
+    return v;
+}
+// Registro con extensión de signo desde su ancho en la traza
+static int64_t getRegistro(const unsigned char*& p) {
+    return static_cast<Registro>(get(p, kBytesRegistro));
+}
+static const char* nombreSemantica(uint64_t s) { return s ? "saturada" : "envolvente"; }
+
+bool operator==(const EventoTraza& a, const EventoTraza& b) {
+    return a.t == b.t && a.pid == b.pid && a.pc == b.pc && a.pcDespues == b.pcDespues
+        && a.ax == b.ax && a.bx == b.bx && a.cx == b.cx;
+}
+
+std::ostream& operator<<(std::ostream& os, const EventoTraza& ev) {
+    return os << "t=" << ev.t << " P" << ev.pid << " PC=" << ev.pc << "->" << ev.pcDespues
+              << " AX=" << ev.ax << " BX=" << ev.bx << " CX=" << ev.cx;
+}
+
+// ---------------- GrabadorTraza ----------------
+
+GrabadorTraza::~GrabadorTraza() { cerrar(); }
+
+bool GrabadorTraza::abrir(const std::string& ruta) {
+    std::FILE* f = std::fopen(ruta.c_str(), "wb");
+    if (!f) return false;
+    abrir(f);
+    propio_ = true;
+    return true;
+}
+
+bool GrabadorTraza::abrir(std::FILE* f) {
+    cerrar();
+    f_ = f;
+    propio_ = false;
+    n_ = 0;
+    unsigned char cab[kTamCabecera];
+    unsigned char* p = cab;
+    std::memcpy(p, kMagia, 8); p += 8;
+    put(p, kVersion, 4);
+    put(p, kBytesRegistro, 4);
+    put(p, kSemantica, 4);
+    return std::fwrite(cab, 1, sizeof(cab), f_) == sizeof(cab);
+}
+
+void GrabadorTraza::instruccion(const EventoTraza& ev) {
+    unsigned char buf[kTamEvento];
+    unsigned char* p = buf;
+    put(p, static_cast<uint64_t>(ev.t), 8);
+    put(p, static_cast<uint32_t>(ev.pid), 4);
+    put(p, static_cast<uint32_t>(ev.pc), 4);
+    put(p, static_cast<uint32_t>(ev.pcDespues), 4);
+    put(p, static_cast<uint64_t>(ev.ax), kBytesRegistro);
+    put(p, static_cast<uint64_t>(ev.bx), kBytesRegistro);
+    put(p, static_cast<uint64_t>(ev.cx), kBytesRegistro);
+    std::fwrite(buf, 1, kTamEvento, f_);
+    n_++;
+}
+
+void GrabadorTraza::cerrar() {
+    if (!f_) return;
+    std::fflush(f_);
+    if (propio_) std::fclose(f_);
+    f_ = nullptr;
+}
+
+// ---------------- VerificadorTraza ----------------
+
+VerificadorTraza::~VerificadorTraza() {
+    if (f_ && propio_) std::fclose(f_);
+}
+
+bool VerificadorTraza::abrir(const std::string& ruta) {
+    std::FILE* f = std::fopen(ruta.c_str(), "rb");
+    if (!f) return false;
+    if (!abrir(f)) { std::fclose(f); return false; }
+    propio_ = true;
+    return true;
+}
+
+bool VerificadorTraza::abrir(std::FILE* f) {
+    f_ = f;
+    propio_ = false;
+    n_ = 0;
+    diverge_ = finEsperado_ = finObtenido_ = false;
+    motivo_.clear();
+    unsigned char cab[kTamCabecera];
+    if (std::fread(cab, 1, sizeof(cab), f_) != sizeof(cab) || std::memcmp(cab, kMagia, 8) != 0) {
+        motivo_ = "no es una traza SIMTRAZA";
+        return false;
+    }
+    const unsigned char* p = cab + 8;
+    const uint64_t version = get(p, 4);
+    if (version != kVersion) {
+        motivo_ = "version " + std::to_string(version) + " no soportada (se espera "
+                + std::to_string(kVersion) + ")";
+        return false;
+    }
+    const uint64_t bytes = get(p, 4);
+    const uint64_t semantica = get(p, 4);
+    if (bytes != kBytesRegistro || semantica != kSemantica) {
+        motivo_ = "grabada con registros de " + std::to_string(8 * bytes) + " bits ("
+                + nombreSemantica(semantica) + "); este binario usa "
+                + std::to_string(8 * kBytesRegistro) + " bits (" + nombreSemantica(kSemantica) + ")";
+        return false;
+    }
+    return true;
+}
+
+bool VerificadorTraza::leer(EventoTraza& ev) {
+    unsigned char buf[kTamEvento];
+    if (std::fread(buf, 1, kTamEvento, f_) != kTamEvento) return false;
+    const unsigned char* p = buf;
+    ev.t = static_cast<int64_t>(get(p, 8));
+    ev.pid = static_cast<int32_t>(get(p, 4));
+    ev.pc = static_cast<int32_t>(get(p, 4));
+    ev.pcDespues = static_cast<int32_t>(get(p, 4));
+    ev.ax = getRegistro(p);
+    ev.bx = getRegistro(p);
+    ev.cx = getRegistro(p);
+    return true;
+}
+
+void VerificadorTraza::instruccion(const EventoTraza& ev) {
+    if (diverge_) return;
+    obtenido_ = ev;
+    if (!leer(esperado_)) {
+        diverge_ = finEsperado_ = true;
+        return;
+    }
+    if (!(esperado_ == ev)) { diverge_ = true; return; }
+    n_++;
+}
+
+void VerificadorTraza::terminar() {
+    if (diverge_) return;
+    if (leer(esperado_)) diverge_ = finObtenido_ = true;
+}